@@ -0,0 +1,40 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+
+static const int kAnimationCount = 100000;
+static const int kFrameCount = 200;
+static const long kFrameInterval = 16L;
+
+int main() {
+    anim::AnimationDriver driver;
+    std::vector<std::unique_ptr<anim::ValueAnimation<float>>> animations;
+    animations.reserve(kAnimationCount);
+    for (int i = 0; i < kAnimationCount; ++i) {
+        animations.emplace_back(new anim::ValueAnimation<float>(0.0f, float(i)));
+        animations.back()->set_driver(&driver);
+        // Staggered durations, so animations keep finishing while the others run
+        animations.back()->SetDuration(kFrameInterval * (kFrameCount / 2 + i % (kFrameCount * 2)));
+        animations.back()->Start();
+    }
+
+    long frame_time = 0L;
+    double total_ns = 0.0;
+    size_t ticked = 0;
+    for (int frame = 0; frame < kFrameCount; ++frame) {
+        ticked += driver.animation_count();
+        auto begin = steady_clock::now();
+        driver.Tick(frame_time);
+        total_ns += duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+        frame_time += kFrameInterval;
+    }
+
+    printf("animations: %d, frames: %d, still running: %zu\n", kAnimationCount, kFrameCount, driver.animation_count());
+    printf("%.3f ms/frame, %.2f ns/animation tick\n", total_ns / kFrameCount / 1e6, total_ns / ticked);
+    return 0;
+}
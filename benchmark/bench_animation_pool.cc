@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_pool.hpp"
+#include "cc_property_animation.hpp"
+
+using namespace std::chrono;
+using anim::Animation;
+using anim::AnimationPool;
+using anim::ClipRef;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::KeyframeClip;
+using anim::PropertyAnimation;
+using anim::ValueAnimation;
+
+static size_t g_allocations = 0;
+
+void *operator new(size_t size) {
+    ++g_allocations;
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// Ripples launched per frame, each lasting about 10 frames
+static const int kLaunchesPerFrame = 20;
+static const long kRippleDuration = 150L;
+static const int kWarmupFrames = 300;
+static const int kFrameCount = 3000;
+static const long kFrameInterval = 16L;
+
+static std::vector<Keyframe<float>> RippleKeyframes() {
+    return {Keyframe<float>(0.0f, 0.0f, EasingCurve(CurveType::OutCubic)), Keyframe<float>(1.0f, 48.0f)};
+}
+
+// Runs the frames launching kLaunchesPerFrame ripples with launch(radius), reports allocations
+// and time per frame once warmed up
+template <typename Launch, typename Collect>
+static void Measure(const char *name, anim::AnimationDriver &driver, Launch launch, Collect collect) {
+    float radius = 0.0f;
+    size_t allocations = 0;
+    steady_clock::time_point begin;
+    for (int frame = 0; frame < kWarmupFrames + kFrameCount; ++frame) {
+        if (kWarmupFrames == frame) {
+            allocations = g_allocations;
+            begin = steady_clock::now();
+        }
+        for (int i = 0; i < kLaunchesPerFrame; ++i) {
+            launch(&radius);
+        }
+        driver.Tick(frame * kFrameInterval);
+        collect();
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    printf("%-34s %14.2f %12.2f\n", name, double(g_allocations - allocations) / kFrameCount, ns / kFrameCount / 1e3);
+}
+
+int main() {
+    const ClipRef<float> clip = KeyframeClip<float>::Create(RippleKeyframes(), milliseconds(kRippleDuration));
+    printf("ripples per frame: %d, %ld ms each\n", kLaunchesPerFrame, kRippleDuration);
+    printf("%-34s %14s %12s\n", "", "allocs/frame", "us/frame");
+    {
+        anim::AnimationDriver driver;
+        std::vector<std::unique_ptr<ValueAnimation<float>>> live;
+        auto collect = [&] {
+            live.erase(std::remove_if(live.begin(), live.end(), [](const std::unique_ptr<ValueAnimation<float>> &a) {
+                return Animation::State::kStopped == a->state();
+            }), live.end());
+        };
+        Measure("new ValueAnimation + subscriber_", driver, [&](float *radius) {
+            live.emplace_back(new ValueAnimation<float>(RippleKeyframes()));
+            live.back()->subscriber_ = [radius](const float &value) { *radius = value; };
+            live.back()->set_driver(&driver);
+            live.back()->SetDuration(kRippleDuration);
+            live.back()->Start();
+        }, collect);
+        live.clear();
+        Measure("new PropertyAnimation, shared clip", driver, [&](float *radius) {
+            live.emplace_back(new PropertyAnimation<float>(radius, clip));
+            live.back()->set_driver(&driver);
+            live.back()->Start();
+        }, collect);
+    }
+    {
+        anim::AnimationDriver driver;
+        AnimationPool<PropertyAnimation<float>> pool(&driver);
+        Measure("AnimationPool, shared clip", driver, [&](float *radius) {
+            pool.Launch(radius, clip);
+        }, [] {});
+    }
+    return 0;
+}
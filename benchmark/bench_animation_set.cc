@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "cc_animation_set.hpp"
+
+using namespace std::chrono;
+using anim::Animation;
+using anim::AnimationSet;
+
+static const long kChildDuration = 100L;
+// Fewer seeks for bigger groups, parallel groups have every child active
+static const long kWorkCount = 20000000L;
+
+class Child : public Animation
+{
+public:
+    void SetDuration(anim::Duration) override {}
+    anim::Duration duration() const override { return std::chrono::milliseconds(kChildDuration); }
+
+protected:
+    void UpdateCurrentTime(anim::Duration) override {}
+};
+
+// Nanoseconds per SetCurrentTime() of the group
+static double Measure(AnimationSet &group, const std::vector<long> &times) {
+    auto begin = steady_clock::now();
+    for (long time : times) {
+        group.SetCurrentTime(time);
+    }
+    return duration_cast<nanoseconds>(steady_clock::now() - begin).count() / double(times.size());
+}
+
+int main() {
+    printf("%-10s %-11s %12s %12s %12s\n", "children", "ordering", "playback", "near seek", "random seek");
+    for (int count : {10, 100, 1000, 10000}) {
+        for (auto ordering : {AnimationSet::Ordering::kSequential, AnimationSet::Ordering::kParallel}) {
+            std::vector<std::unique_ptr<Child>> children;
+            AnimationSet group(ordering);
+            for (int i = 0; i < count; ++i) {
+                children.emplace_back(new Child);
+                group.AddAnimation(children.back().get());
+            }
+            group.set_loop_count(Animation::INFINITE);
+            group.Start();
+            group.Pause();
+
+            // Frames 16 ms apart, back and forth within a child or two, and anywhere
+            const long duration = group.GetDuration();
+            std::vector<long> playback, near, random;
+            const long seek_count = std::max(1000L, kWorkCount / count);
+            for (long i = 0; i < seek_count; ++i) {
+                playback.push_back((16L * i) % duration);
+                near.push_back(duration / 2 + rand() % std::min(2 * kChildDuration, duration / 2));
+                random.push_back(rand() % duration);
+            }
+            printf("%-10d %-11s %12.1f %12.1f %12.1f\n", count,
+                   AnimationSet::Ordering::kSequential == ordering ? "sequential" : "parallel",
+                   Measure(group, playback), Measure(group, near), Measure(group, random));
+            group.Stop();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_change_log.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+
+static const int kAnimationCount = 100000;
+static const int kFrameCount = 100;
+static const long kFrameInterval = 16L;
+
+struct Node
+{
+    float opacity = 0.0f;
+    char other_state[60];
+};
+
+// ns per animation and frame to tick and apply the values to the nodes. One animation in
+// `still_every` holds its value, so it has nothing to report after its first frame
+static double Measure(bool use_log, int still_every, std::vector<Node> &nodes) {
+    anim::AnimationDriver driver;
+    anim::ChangeLog<float> log;
+    log.Reserve(kAnimationCount);
+    driver.AddChangeLog(&log);
+    std::vector<std::unique_ptr<anim::ValueAnimation<float>>> animations;
+    animations.reserve(kAnimationCount);
+    for (int i = 0; i < kAnimationCount; ++i) {
+        const float end = (i % still_every == 0) ? 0.5f : 1.0f;
+        animations.emplace_back(new anim::ValueAnimation<float>(0.5f, end));
+        anim::ValueAnimation<float> &animation = *animations.back();
+        animation.set_driver(&driver);
+        animation.SetDuration(kFrameInterval * kFrameCount * 2);
+        if (use_log) {
+            animation.set_change_log(&log, uint32_t(i));
+        } else {
+            Node *node = &nodes[i];
+            animation.subscriber_ = [node](const float &value) { node->opacity = value; };
+        }
+        animation.Start();
+    }
+
+    driver.Tick(0L);
+    auto begin = steady_clock::now();
+    for (int frame = 1; frame <= kFrameCount; ++frame) {
+        driver.Tick(frame * kFrameInterval);
+        for (const auto &entry : log) {
+            nodes[entry.id].opacity = entry.value;
+        }
+    }
+    return duration_cast<nanoseconds>(steady_clock::now() - begin).count() / double(kAnimationCount) / kFrameCount;
+}
+
+int main() {
+    std::vector<Node> nodes(kAnimationCount);
+    printf("animations: %d, frames: %d, ns/animation/frame including applying the values\n", kAnimationCount, kFrameCount);
+    for (int still_every : {1000000, 2, 1}) {
+        const double subscriber = Measure(false, still_every, nodes);
+        const double log = Measure(true, still_every, nodes);
+        printf("%3d%% still: subscriber %6.2f, change log %6.2f, %.2fx\n",
+               still_every == 1000000 ? 0 : 100 / still_every, subscriber, log, subscriber / log);
+    }
+    return 0;
+}
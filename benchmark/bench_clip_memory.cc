@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_clip_player.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+using anim::ClipPlayer;
+using anim::ClipRef;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::KeyframeClip;
+using anim::ValueAnimation;
+
+static size_t g_allocations = 0;
+static size_t g_bytes = 0;
+
+void *operator new(size_t size) {
+    ++g_allocations;
+    g_bytes += size;
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static const int kInstanceCount = 100000;
+static const int kFrameCount = 100;
+
+// The track of a list row fading and sliding in
+static std::vector<Keyframe<float>> RowKeyframes() {
+    return {Keyframe<float>(0.0f, 0.0f, EasingCurve(CurveType::OutCubic)), Keyframe<float>(0.3f, 0.6f),
+            Keyframe<float>(0.7f, 0.9f, EasingCurve(CurveType::OutBack)), Keyframe<float>(1.0f, 1.0f)};
+}
+
+static void Report(const char *name, size_t object_size, size_t allocations, size_t bytes, double tick_ns) {
+    printf("%-26s %8zu %14.2f %14.1f %10.2f\n", name, object_size, double(allocations) / kInstanceCount,
+           double(bytes) / kInstanceCount, tick_ns);
+}
+
+// ns per instance and frame
+template <typename Advance>
+static double MeasureTick(Advance advance) {
+    auto begin = steady_clock::now();
+    for (int frame = 1; frame <= kFrameCount; ++frame) {
+        advance(frame);
+    }
+    return duration_cast<nanoseconds>(steady_clock::now() - begin).count() / double(kInstanceCount) / kFrameCount;
+}
+
+template <typename Make>
+static void MeasureAnimations(const char *name, Make make) {
+    std::vector<std::unique_ptr<ValueAnimation<float>>> animations;
+    animations.reserve(kInstanceCount);
+    const size_t allocations = g_allocations, bytes = g_bytes;
+    for (int i = 0; i < kInstanceCount; ++i) {
+        animations.emplace_back(make());
+    }
+    const size_t added_allocations = g_allocations - allocations, added_bytes = g_bytes - bytes;
+    anim::AnimationDriver driver;
+    for (auto &animation : animations) {
+        animation->set_driver(&driver);
+        animation->SetDuration(kFrameCount * 16L * 2);
+        animation->Start();
+    }
+    const double tick_ns = MeasureTick([&](int frame) { driver.Tick(frame * 16L); });
+    Report(name, sizeof(ValueAnimation<float>), added_allocations, added_bytes, tick_ns);
+}
+
+int main() {
+    const ClipRef<float> clip = KeyframeClip<float>::Create(RowKeyframes(), milliseconds(kFrameCount * 16 * 2));
+    printf("instances: %d, keyframes: 4\n", kInstanceCount);
+    printf("%-26s %8s %14s %14s %10s\n", "", "sizeof", "allocs/inst", "heap B/inst", "tick ns");
+    MeasureAnimations("ValueAnimation, own", [] { return new ValueAnimation<float>(RowKeyframes()); });
+    MeasureAnimations("ValueAnimation, shared", [&] { return new ValueAnimation<float>(clip); });
+
+    std::vector<ClipPlayer<float>> players;
+    const size_t allocations = g_allocations, bytes = g_bytes;
+    players.reserve(kInstanceCount);
+    for (int i = 0; i < kInstanceCount; ++i) {
+        players.emplace_back(clip);
+        players.back().Start();
+    }
+    const size_t added_allocations = g_allocations - allocations, added_bytes = g_bytes - bytes;
+    const double tick_ns = MeasureTick([&](int) {
+        for (auto &player : players) player.Advance(milliseconds(16));
+    });
+    Report("ClipPlayer, shared", sizeof(ClipPlayer<float>), added_allocations, added_bytes, tick_ns);
+    return 0;
+}
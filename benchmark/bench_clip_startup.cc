@@ -0,0 +1,145 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "cc_animation_driver.hpp"
+#include "cc_clip_file.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+using anim::BakedClip;
+using anim::ClipFile;
+using anim::ClipWriter;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::ValueAnimation;
+
+static const int kClipCount = 20000;
+static const int kFrameCount = 100;
+static const long kFrameInterval = 16L;
+static const char *kPath = "bench_clip_startup.ccac";
+
+using Animations = std::vector<std::unique_ptr<ValueAnimation<float>>>;
+
+static std::string ClipName(int i) {
+    return "clip_" + std::to_string(i);
+}
+
+// What an application does at startup without baked clips, 6 keyframes per clip
+static ValueAnimation<float> *MakeFromKeyframes(int i) {
+    const float v = float(i % 100);
+    return new ValueAnimation<float>({
+        Keyframe<float>(0.0f, 0.0f, EasingCurve(CurveType::OutBack)),
+        Keyframe<float>(0.2f, v, EasingCurve::Bezier(0.3f, 0.0f, 0.2f, 1.0f)),
+        Keyframe<float>(0.4f, v * 0.5f, EasingCurve(CurveType::InOutQuad)),
+        Keyframe<float>(0.6f, v * 0.8f),
+        Keyframe<float>(0.8f, v * 0.2f, EasingCurve(CurveType::OutBounce)),
+        Keyframe<float>(1.0f, 1.0f)});
+}
+
+// ns per animation tick over kFrameCount frames
+static double MeasureTick(Animations &animations) {
+    anim::AnimationDriver driver;
+    for (auto &animation : animations) {
+        animation->set_driver(&driver);
+        animation->SetDuration(kFrameInterval * kFrameCount * 2);
+        animation->Start();
+    }
+    driver.Tick(0L);
+    auto begin = steady_clock::now();
+    for (int frame = 1; frame <= kFrameCount; ++frame) {
+        driver.Tick(frame * kFrameInterval);
+    }
+    return duration_cast<nanoseconds>(steady_clock::now() - begin).count() / double(animations.size()) / kFrameCount;
+}
+
+int main() {
+    {
+        ClipWriter writer;
+        for (int i = 0; i < kClipCount; ++i) {
+            std::unique_ptr<ValueAnimation<float>> animation(MakeFromKeyframes(i));
+            writer.AddClip(ClipName(i), animation->keyframes(), milliseconds(500));
+        }
+        writer.Write(kPath);
+    }
+    std::vector<std::string> names;
+    for (int i = 0; i < kClipCount; ++i) {
+        names.push_back(ClipName(i));
+    }
+
+    printf("clips: %d\n", kClipCount);
+    // Grows the heap once for the 3 sets of animations alive at the end, so none of them pays for
+    // fresh pages. glibc would hand the freed pages back to the system, only to fault them in again
+#if defined(__GLIBC__)
+    mallopt(M_TRIM_THRESHOLD, 1 << 30);
+#endif
+    {
+        Animations warmup;
+        for (int i = 0; i < 3 * kClipCount; ++i) {
+            warmup.emplace_back(MakeFromKeyframes(i % kClipCount));
+        }
+    }
+    Animations built;
+    built.reserve(kClipCount);
+    auto begin = steady_clock::now();
+    for (int i = 0; i < kClipCount; ++i) {
+        built.emplace_back(MakeFromKeyframes(i));
+    }
+    const double build_ms = duration_cast<microseconds>(steady_clock::now() - begin).count() / 1e3;
+
+    Animations mapped;
+    mapped.reserve(kClipCount);
+    begin = steady_clock::now();
+    ClipFile file;
+    if (!file.Open(kPath)) {
+        printf("can't open %s\n", kPath);
+        return 1;
+    }
+    const double open_ms = duration_cast<microseconds>(steady_clock::now() - begin).count() / 1e3;
+    for (int i = 0; i < kClipCount; ++i) {
+        BakedClip<float> clip;
+        file.GetClip(names[i].c_str(), &clip);
+        mapped.emplace_back(new ValueAnimation<float>(clip));
+    }
+    const double map_ms = duration_cast<microseconds>(steady_clock::now() - begin).count() / 1e3;
+
+    // Clips addressed by index, e.g. resolved once by an asset pipeline
+    Animations indexed;
+    indexed.reserve(kClipCount);
+    begin = steady_clock::now();
+    for (int i = 0; i < kClipCount; ++i) {
+        BakedClip<float> clip;
+        file.GetClip(size_t(i), &clip);
+        indexed.emplace_back(new ValueAnimation<float>(clip));
+    }
+    const double index_ms = duration_cast<microseconds>(steady_clock::now() - begin).count() / 1e3;
+
+    // The name lookups alone, through the hashed name table of the file
+    long found = 0;
+    begin = steady_clock::now();
+    for (int i = 0; i < kClipCount; ++i) {
+        found += file.FindClip(names[i].c_str()) >= 0;
+    }
+    const double lookup_ms = duration_cast<microseconds>(steady_clock::now() - begin).count() / 1e3;
+
+    printf("startup, ms:\n");
+    printf("  initializer_list keyframes:  %8.2f\n", build_ms);
+    printf("  mapped clips, by name:       %8.2f (open %.2f, %s), %.2fx\n", map_ms, open_ms,
+           file.is_mapped() ? "mmap" : "read", build_ms / map_ms);
+    printf("  mapped clips, by index:      %8.2f, %.2fx\n", index_ms, build_ms / index_ms);
+    printf("  name lookups alone:          %8.2f (%ld found, %.0f ns/lookup)\n", lookup_ms, found,
+           lookup_ms * 1e6 / kClipCount);
+    printf("tick, ns/animation:\n");
+    printf("  initializer_list keyframes:  %8.2f\n", MeasureTick(built));
+    printf("  mapped clips:                %8.2f\n", MeasureTick(mapped));
+    indexed.clear();
+    mapped.clear();
+    file.Close();
+    std::remove(kPath);
+    return 0;
+}
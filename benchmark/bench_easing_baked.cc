@@ -0,0 +1,62 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "cc_easing_curve.hpp"
+
+using namespace std::chrono;
+using anim::CurveType;
+using anim::EasingCurve;
+
+static const size_t kValueCount = 4096;
+static const int kRepeatCount = 500;
+
+// Nanoseconds per ValueForProgress() call
+static double Measure(const EasingCurve &curve, const std::vector<float> &progress) {
+    float sink = 0.0f;
+    auto begin = steady_clock::now();
+    for (int i = 0; i < kRepeatCount; ++i) {
+        for (float p : progress) sink += curve.ValueForProgress(p);
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    if (sink == 1.0f) printf(" ");
+    return ns / (double(progress.size()) * kRepeatCount);
+}
+
+int main() {
+    const struct {
+        const char *name;
+        CurveType type;
+    } curves[] = {
+        {"InSine", CurveType::InSine}, {"OutSine", CurveType::OutSine},
+        {"InOutSine", CurveType::InOutSine}, {"OutInSine", CurveType::OutInSine},
+        {"InExpo", CurveType::InExpo}, {"OutExpo", CurveType::OutExpo},
+        {"InOutExpo", CurveType::InOutExpo}, {"OutInExpo", CurveType::OutInExpo},
+        {"InCirc", CurveType::InCirc}, {"OutCirc", CurveType::OutCirc},
+        {"InOutCirc", CurveType::InOutCirc}, {"OutInCirc", CurveType::OutInCirc},
+        {"InElastic", CurveType::InElastic}, {"OutElastic", CurveType::OutElastic},
+        {"InOutElastic", CurveType::InOutElastic}, {"OutInElastic", CurveType::OutInElastic},
+        {"InCurve", CurveType::InCurve}, {"OutCurve", CurveType::OutCurve},
+        {"SineCurve", CurveType::SineCurve}, {"CosineCurve", CurveType::CosineCurve},
+    };
+    const int resolutions[] = {64, 256, 1024};
+
+    std::vector<float> progress(kValueCount);
+    for (size_t i = 0; i < kValueCount; ++i) {
+        // Scrambled, so the table lookups don't walk memory in order
+        progress[i] = float((i * 2654435761u) % kValueCount) / float(kValueCount - 1);
+    }
+
+    printf("%-14s %12s", "", "analytic ns");
+    for (int resolution : resolutions) printf("   baked/%-4d ns   max error", resolution);
+    printf("\n");
+    for (const auto &entry : curves) {
+        const EasingCurve curve(entry.type);
+        printf("%-14s %12.2f", entry.name, Measure(curve, progress));
+        for (int resolution : resolutions) {
+            const EasingCurve baked = curve.Baked(resolution);
+            printf("   %13.2f %11.3g", Measure(baked, progress), baked.baked_max_error());
+        }
+        printf("\n");
+    }
+    return 0;
+}
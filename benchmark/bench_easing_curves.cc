@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "cc_easing_curve.hpp"
+
+using namespace std::chrono;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::SimdLevel;
+
+static const size_t kValueCount = 4096;
+static const int kRepeatCount = 500;
+
+static const char *kLevelNames[] = {"scalar", "sse2", "avx2", "neon"};
+
+static const char *kCurveNames[] = {
+    "Linear", "InQuad", "OutQuad", "InOutQuad", "OutInQuad", "InCubic", "OutCubic", "InOutCubic", "OutInCubic",
+    "InQuart", "OutQuart", "InOutQuart", "OutInQuart", "InQuint", "OutQuint", "InOutQuint", "OutInQuint",
+    "InSine", "OutSine", "InOutSine", "OutInSine", "InExpo", "OutExpo", "InOutExpo", "OutInExpo",
+    "InCirc", "OutCirc", "InOutCirc", "OutInCirc", "InElastic", "OutElastic", "InOutElastic", "OutInElastic",
+    "InBack", "OutBack", "InOutBack", "OutInBack", "InBounce", "OutBounce", "InOutBounce", "OutInBounce",
+    "InCurve", "OutCurve", "SineCurve", "CosineCurve", "CubicBezier"};
+
+// Millions of values per second
+static double Measure(const EasingCurve &curve, const std::vector<float> &progress, std::vector<float> &values) {
+    auto begin = steady_clock::now();
+    for (int i = 0; i < kRepeatCount; ++i) {
+        curve.ValuesForProgress(progress.data(), values.data(), progress.size());
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    return double(progress.size()) * kRepeatCount / ns * 1e3;
+}
+
+static double MeasurePerValue(const EasingCurve &curve, const std::vector<float> &progress, std::vector<float> &values) {
+    auto begin = steady_clock::now();
+    for (int i = 0; i < kRepeatCount; ++i) {
+        for (size_t j = 0; j < progress.size(); ++j) {
+            values[j] = curve.ValueForProgress(progress[j]);
+        }
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    return double(progress.size()) * kRepeatCount / ns * 1e3;
+}
+
+static void PrintRow(const char *name, const EasingCurve &curve, const std::vector<float> &progress, std::vector<float> &values) {
+    printf("%-14s %14.1f", name, MeasurePerValue(curve, progress, values));
+    for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse2, SimdLevel::kAvx2, SimdLevel::kNeon}) {
+        if (EasingCurve::SetSimdLevel(level)) printf(" %10.1f", Measure(curve, progress, values));
+    }
+    printf("\n");
+}
+
+int main() {
+    const SimdLevel best = EasingCurve::simd_level();
+    std::vector<float> progress(kValueCount);
+    std::vector<float> values(kValueCount);
+    for (size_t i = 0; i < kValueCount; ++i) {
+        progress[i] = float(i) / float(kValueCount - 1);
+    }
+
+    printf("%-14s %14s", "Mvalues/s", "per-value");
+    for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse2, SimdLevel::kAvx2, SimdLevel::kNeon}) {
+        if (EasingCurve::SetSimdLevel(level)) printf(" %10s", kLevelNames[int(level)]);
+    }
+    printf("\n");
+    for (int type = 0; type < int(CurveType::Custom); ++type) {
+        PrintRow(kCurveNames[type], EasingCurve{CurveType(type)}, progress, values);
+    }
+    // CSS "ease" again, starting Newton's method from the sample table
+    PrintRow("Bezier+table", EasingCurve::Bezier(0.25f, 0.1f, 0.25f, 1.0f, true), progress, values);
+    EasingCurve::SetSimdLevel(best);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using std::chrono::nanoseconds;
+
+static const long kDurationMs = 1000L;
+
+// Ticks a linear animation with the vsync times of the given refresh rate, passed in whole
+// milliseconds (the former timing model) or in nanoseconds, and compares how far each frame moved
+// the progress with the ideal frame interval
+static void Measure(int hz, bool milliseconds) {
+    anim::AnimationDriver driver;
+    anim::ValueAnimation<float> animation(0.0f, 1.0f);
+    animation.set_driver(&driver);
+    animation.SetDuration(kDurationMs);
+    animation.set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+    float value = 0.0f;
+    animation.subscriber_ = [&value](const float &v) { value = v; };
+    animation.Start();
+
+    // An arbitrary clock origin, not aligned on a millisecond
+    const long origin_ns = 123456789012L;
+    const double ideal_step = 1000.0 / hz / kDurationMs;
+    double total_error = 0.0, max_error = 0.0;
+    int frames = 0, stalled = 0;
+    float last_value = 0.0f;
+    for (long frame = 0; !driver.IsIdle(); ++frame) {
+        const long time_ns = origin_ns + long(frame * 1e9 / hz);
+        if (milliseconds) {
+            driver.Tick(time_ns / 1000000L);
+        } else {
+            driver.Tick(nanoseconds(time_ns));
+        }
+        if (frame == 0 || anim::Animation::State::kRunning != animation.state()) {
+            last_value = value;
+            continue;
+        }
+        const double error = std::fabs((value - last_value) - ideal_step) / ideal_step;
+        total_error += error;
+        max_error = std::max(max_error, error);
+        stalled += (value == last_value);
+        ++frames;
+        last_value = value;
+    }
+    printf("%3d Hz, %-11s: mean step error %6.2f%%, max %6.2f%%, %d frames without progress\n",
+           hz, milliseconds ? "long ms" : "nanoseconds", 100.0 * total_error / frames, 100.0 * max_error, stalled);
+}
+
+int main() {
+    printf("frame-to-frame progress of a %ld ms linear animation against the ideal step\n", kDurationMs);
+    for (int hz : {60, 144, 240, 360}) {
+        Measure(hz, true);
+        Measure(hz, false);
+    }
+    return 0;
+}
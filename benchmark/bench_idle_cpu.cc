@@ -0,0 +1,87 @@
+// CPU use of an event loop driving animations, polling every 10 ms against sleeping on the
+// driver's deadline through AnimationTimer. Linux only.
+#include <cstdio>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_timer.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+
+static const milliseconds kRunTime(2000);
+
+static double CpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void Report(const char *name, int animations, double cpu, long wakeups) {
+    const double wall = duration_cast<duration<double>>(kRunTime).count();
+    printf("%-9s %d animation%s: %6.3f%% CPU, %5.1f wakeups/s\n", name, animations, animations == 1 ? " " : "s",
+           100.0 * cpu / wall, wakeups / wall);
+}
+
+static void Setup(anim::AnimationDriver &driver, anim::ValueAnimation<float> &animation, int animations) {
+    animation.set_driver(&driver);
+    animation.set_loop_count(anim::Animation::INFINITE);
+    animation.SetDuration(1000);
+    if (animations > 0) animation.Start();
+}
+
+static void Poll(int animations) {
+    anim::AnimationDriver driver;
+    anim::ValueAnimation<float> animation(0.0f, 1.0f);
+    Setup(driver, animation, animations);
+    const double cpu = CpuSeconds();
+    const auto end = steady_clock::now() + kRunTime;
+    long wakeups = 0;
+    while (steady_clock::now() < end) {
+        driver.Tick();
+        std::this_thread::sleep_for(milliseconds(10));
+        ++wakeups;
+    }
+    Report("polling", animations, CpuSeconds() - cpu, wakeups);
+}
+
+static void Timer(int animations) {
+    anim::AnimationDriver driver;
+    anim::ValueAnimation<float> animation(0.0f, 1.0f);
+    Setup(driver, animation, animations);
+    anim::AnimationTimer timer(&driver);
+    const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer.fd(), &event);
+    const double cpu = CpuSeconds();
+    const auto end = steady_clock::now() + kRunTime;
+    long wakeups = 0;
+    for (auto now = steady_clock::now(); now < end; now = steady_clock::now()) {
+        const int timeout = int(duration_cast<milliseconds>(end - now).count()) + 1;
+        if (epoll_wait(epoll_fd, &event, 1, timeout) > 0) {
+            timer.OnReadable();
+            ++wakeups;
+        }
+    }
+    close(epoll_fd);
+    Report("timerfd", animations, CpuSeconds() - cpu, wakeups);
+}
+
+int main() {
+    for (int animations : {0, 1}) {
+        Poll(animations);
+        Timer(animations);
+    }
+    return 0;
+}
+#else
+int main() {
+    printf("timerfd is Linux only\n");
+    return 0;
+}
+#endif
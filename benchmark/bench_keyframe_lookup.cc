@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "cc_keyframe.hpp"
+
+using namespace std::chrono;
+using anim::Keyframe;
+using anim::KeyframeIndex;
+
+static const int kLookupCount = 1 << 20;
+
+// The lookup ValueAnimation::RecalculateCurrentInterval() used to do: lower_bound when the
+// progress leaves the cached interval, copying both keyframes
+struct LegacyLookup
+{
+    struct {
+        Keyframe<float> start, end;
+    } current_interval_;
+
+    float ValueForProgress(const std::vector<Keyframe<float>> &keyframes_, float progress) {
+        if (current_interval_.start.progress() == current_interval_.end.progress()
+            || (current_interval_.start.progress() > 0 && progress < current_interval_.start.progress())
+            || (current_interval_.end.progress() < 1 && progress > current_interval_.end.progress())) {
+            auto it = std::lower_bound(keyframes_.cbegin(), keyframes_.cend(), Keyframe<float>(progress, 0.0f));
+            if (it == keyframes_.cbegin()) {
+                if (it->progress() == 0) {
+                    current_interval_.start = *it;
+                    current_interval_.end = *(it + 1);
+                }
+            } else if (it == keyframes_.cend()) {
+                --it;
+                if (it->progress() == 1) {
+                    current_interval_.start = *(it - 1);
+                    current_interval_.end = *it;
+                }
+            } else {
+                current_interval_.start = *(it - 1);
+                current_interval_.end = *it;
+            }
+        }
+        const float start = current_interval_.start.progress();
+        const float local = (progress - start) / (current_interval_.end.progress() - start);
+        return current_interval_.start.value() + (current_interval_.end.value() - current_interval_.start.value()) * local;
+    }
+};
+
+struct IndexedLookup
+{
+    KeyframeIndex index;
+    size_t current_interval_ = 0;
+
+    float ValueForProgress(const std::vector<Keyframe<float>> &keyframes, float progress) {
+        current_interval_ = index.Find(keyframes, progress, current_interval_);
+        const Keyframe<float> &start = keyframes[current_interval_];
+        const Keyframe<float> &end = keyframes[current_interval_ + 1];
+        const float local = (progress - start.progress()) / (end.progress() - start.progress());
+        return start.value() + (end.value() - start.value()) * local;
+    }
+};
+
+// Every lookup adds to it, so none of them is optimized out
+static volatile float g_sink = 0.0f;
+
+// Nanoseconds per lookup
+template <typename Lookup>
+static double Measure(Lookup &lookup, const std::vector<Keyframe<float>> &keyframes, const std::vector<float> &progress) {
+    float sum = 0.0f;
+    auto begin = steady_clock::now();
+    for (float p : progress) {
+        sum += lookup.ValueForProgress(keyframes, p);
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    g_sink = g_sink + sum;
+    return ns / double(progress.size());
+}
+
+int main() {
+    printf("%-10s %-12s %10s %10s\n", "keyframes", "ns/lookup", "legacy", "indexed");
+    for (size_t count : {2, 16, 500, 5000}) {
+        // Unevenly spaced, like recorded motion
+        std::vector<Keyframe<float>> keyframes;
+        for (size_t i = 0; i < count; ++i) {
+            const float x = float(i) / float(count - 1);
+            keyframes.emplace_back(x * (0.5f + 0.5f * x), float(rand() % 1000));
+        }
+
+        // Playing a 10 s track at 60 fps back and forth, and scrubbing to random positions
+        std::vector<float> sequential;
+        std::vector<float> random;
+        for (int i = 0; i < kLookupCount; ++i) {
+            const int frame = i % 1200;
+            sequential.push_back(float(frame < 600 ? frame : 1200 - frame) / 600.0f);
+            random.push_back(float(rand()) / float(RAND_MAX));
+        }
+
+        LegacyLookup legacy;
+        IndexedLookup indexed;
+        indexed.index.Build(keyframes);
+        printf("%-10zu %-12s %10.2f %10.2f\n", count, "sequential",
+               Measure(legacy, keyframes, sequential), Measure(indexed, keyframes, sequential));
+        printf("%-10zu %-12s %10.2f %10.2f\n", count, "random",
+               Measure(legacy, keyframes, random), Measure(indexed, keyframes, random));
+    }
+    printf("checksum: %g\n", double(g_sink));
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <new>
+#include <vector>
+#include "cc_animation.hpp"
+#include "cc_listener_list.hpp"
+
+using namespace std::chrono;
+using anim::Animation;
+using anim::AnimationListener;
+using anim::ListenerList;
+
+static size_t g_allocations = 0;
+
+void *operator new(size_t size) {
+    ++g_allocations;
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static const int kListsCount = 10000;
+static const int kDispatchCount = 200;
+
+struct CountingListener : AnimationListener
+{
+    long repeats = 0;
+    void OnAnimationRepeat(Animation &) override { ++repeats; }
+};
+
+// What Animation used to hold: a lazily allocated list of shared listeners
+struct LegacyListeners
+{
+    std::unique_ptr<std::list<std::shared_ptr<AnimationListener>>> listeners_;
+
+    void Add(const std::shared_ptr<AnimationListener> &listener) {
+        if (nullptr == listeners_) {
+            listeners_ = decltype(listeners_)(new std::list<std::shared_ptr<AnimationListener>>());
+        }
+        listeners_->push_back(listener);
+    }
+
+    void Notify(Animation &animation) {
+        if (!listeners_) return;
+        // Copy each pointer, as a dispatch safe against removal has to
+        for (auto it = listeners_->begin(); it != listeners_->end();) {
+            std::shared_ptr<AnimationListener> listener = *it++;
+            listener->OnAnimationRepeat(animation);
+        }
+    }
+};
+
+struct InlineListeners
+{
+    ListenerList<AnimationListener> listeners_;
+
+    void Add(AnimationListener *listener) { listeners_.Add(listener); }
+
+    void Notify(Animation &animation) {
+        listeners_.Dispatch([&animation](AnimationListener &listener) { listener.OnAnimationRepeat(animation); });
+    }
+};
+
+// Any animation does, only its address is passed along
+struct NullAnimation : Animation
+{
+    void SetDuration(anim::Duration) override {}
+    anim::Duration duration() const override { return anim::Duration::zero(); }
+    void UpdateCurrentTime(anim::Duration) override {}
+};
+
+template <typename Lists, typename AddListeners>
+static void Run(const char *name, int listeners_per_animation, AddListeners add) {
+    NullAnimation animation;
+    std::vector<Lists> lists(kListsCount);
+    const size_t allocations = g_allocations;
+    for (auto &list : lists) {
+        for (int i = 0; i < listeners_per_animation; ++i) add(list);
+    }
+    const size_t add_allocations = g_allocations - allocations;
+
+    auto begin = steady_clock::now();
+    for (int i = 0; i < kDispatchCount; ++i) {
+        for (auto &list : lists) list.Notify(animation);
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    const size_t dispatch_allocations = g_allocations - allocations - add_allocations;
+    printf("%-8s %9d %14.2f %14.2f %12zu\n", name, listeners_per_animation,
+           double(add_allocations) / kListsCount, ns / (double(kListsCount) * kDispatchCount),
+           dispatch_allocations);
+}
+
+int main() {
+    printf("%-8s %9s %14s %14s %12s\n", "", "listeners", "allocs/anim", "ns/dispatch", "tick allocs");
+    for (int count : {1, 2, 4}) {
+        // The listeners are created up front, only the allocations of the lists are counted
+        std::vector<std::shared_ptr<AnimationListener>> shared;
+        for (int i = 0; i < kListsCount * count; ++i) {
+            shared.push_back(std::make_shared<CountingListener>());
+        }
+        size_t next = 0;
+        Run<LegacyListeners>("legacy", count, [&shared, &next](LegacyListeners &list) {
+            list.Add(shared[next++]);
+        });
+        next = 0;
+        Run<InlineListeners>("inline", count, [&shared, &next](InlineListeners &list) {
+            list.Add(shared[next++].get());
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cc_animation_baker.hpp"
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+using anim::AnimationBaker;
+using anim::CurveType;
+using anim::Duration;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::ValueAnimation;
+
+static const int kAnimationCount = 10000;
+static const size_t kFrameCount = 600;
+// 60 fps
+static const Duration kInterval = microseconds(16667);
+
+using Animations = std::vector<std::unique_ptr<ValueAnimation<float>>>;
+
+static Animations MakeAnimations() {
+    Animations animations;
+    for (int i = 0; i < kAnimationCount; ++i) {
+        animations.emplace_back(new ValueAnimation<float>({
+            Keyframe<float>(0.0f, 0.0f, EasingCurve(CurveType(i % 8))),
+            Keyframe<float>(0.4f, float(i % 100), EasingCurve(CurveType::OutCubic)),
+            Keyframe<float>(1.0f, 1.0f)}));
+        animations.back()->SetDuration(kInterval * long(kFrameCount - 1));
+    }
+    return animations;
+}
+
+// Millions of samples per second
+template <typename Bake>
+static double Measure(Bake bake) {
+    auto begin = steady_clock::now();
+    bake();
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    return double(kAnimationCount) * kFrameCount / ns * 1e3;
+}
+
+int main() {
+    Animations animations = MakeAnimations();
+    std::vector<const ValueAnimation<float> *> pointers;
+    for (auto &animation : animations) {
+        pointers.push_back(animation.get());
+    }
+    std::vector<float> frames(size_t(kAnimationCount) * kFrameCount);
+
+    printf("animations: %d, frames: %zu, hardware threads: %u\n", kAnimationCount, kFrameCount,
+           std::thread::hardware_concurrency());
+    printf("Msamples/s:\n");
+    printf("  driver tick per frame:   %8.2f\n", Measure([&] {
+        anim::AnimationDriver driver;
+        for (auto &animation : animations) {
+            animation->set_driver(&driver);
+            animation->Start();
+        }
+        for (size_t f = 0; f < kFrameCount; ++f) {
+            driver.Tick(kInterval * long(f));
+            for (size_t a = 0; a < animations.size(); ++a) {
+                frames[a * kFrameCount + f] = animations[a]->current_value();
+            }
+        }
+    }));
+    printf("  Evaluate() per sample:   %8.2f\n", Measure([&] {
+        for (size_t a = 0; a < pointers.size(); ++a) {
+            for (size_t f = 0; f < kFrameCount; ++f) {
+                frames[a * kFrameCount + f] = pointers[a]->Evaluate(kInterval * long(f));
+            }
+        }
+    }));
+    AnimationBaker baker;
+    for (int threads : {1, 2, 4, 8}) {
+        baker.set_thread_count(threads);
+        printf("  AnimationBaker, %d thr:  %8.2f\n", threads, Measure([&] {
+            baker.Bake(pointers.data(), pointers.size(), kInterval, kFrameCount, frames.data());
+        }));
+    }
+    return 0;
+}
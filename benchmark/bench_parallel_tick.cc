@@ -0,0 +1,58 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+using anim::Keyframe;
+
+static const int kAnimationCount = 100000;
+static const int kFrameCount = 100;
+static const long kFrameInterval = 16L;
+
+// Average time of a frame updating every animation with the given number of threads
+static double MeasureFrame(int thread_count) {
+    anim::AnimationDriver driver;
+    driver.set_thread_count(thread_count);
+    std::vector<std::unique_ptr<anim::ValueAnimation<float>>> animations;
+    animations.reserve(kAnimationCount);
+    float sink = 0.0f;
+    for (int i = 0; i < kAnimationCount; ++i) {
+        animations.emplace_back(new anim::ValueAnimation<float>({
+            Keyframe<float>(0.0f, 0.5f),
+            Keyframe<float>(0.3f, float(i), anim::EasingCurve(anim::CurveType::OutElastic)),
+            Keyframe<float>(0.7f, -float(i), anim::EasingCurve(anim::CurveType::InOutSine)),
+            Keyframe<float>(1.0f, 0.0f),
+        }));
+        animations.back()->set_driver(&driver);
+        // Longer than the run, so every frame updates every animation
+        animations.back()->SetDuration(kFrameInterval * kFrameCount * 2);
+        animations.back()->subscriber_ = [&sink](const float &value) { sink += value; };
+        animations.back()->Start();
+    }
+
+    driver.Tick(0L);
+    double total_ns = 0.0;
+    for (int frame = 1; frame <= kFrameCount; ++frame) {
+        auto begin = steady_clock::now();
+        driver.Tick(frame * kFrameInterval);
+        total_ns += duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    }
+    if (sink == 1.0f) printf(" ");
+    return total_ns / kFrameCount;
+}
+
+int main() {
+    printf("animations: %d, frames: %d, hardware threads: %u\n", kAnimationCount, kFrameCount,
+           std::thread::hardware_concurrency());
+    const double serial_ns = MeasureFrame(1);
+    printf("threads  1: %8.3f ms/frame\n", serial_ns / 1e6);
+    for (int thread_count : {2, 4, 8, 16}) {
+        const double ns = MeasureFrame(thread_count);
+        printf("threads %2d: %8.3f ms/frame, %.2fx\n", thread_count, ns / 1e6, serial_ns / ns);
+    }
+    return 0;
+}
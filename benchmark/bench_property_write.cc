@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "cc_animation_batch.hpp"
+#include "cc_animation_driver.hpp"
+#include "cc_property_animation.hpp"
+
+using namespace std::chrono;
+using anim::PropertyAnimation;
+using anim::SetterProperty;
+
+static const int kAnimationCount = 50000;
+static const int kFrameCount = 200;
+static const long kFrameInterval = 16L;
+// Long enough for nothing to finish during the run
+static const long kDuration = kFrameInterval * kFrameCount * 2;
+
+struct Sprite
+{
+    void set_alpha(float alpha) { alpha_ = alpha; }
+    float x = 0.0f, y = 0.0f;
+    float alpha_ = 0.0f;
+};
+
+// Ticks the animations made by make(i) for kFrameCount frames, returns ns per animation tick
+template <typename Make>
+static double MeasureTick(Make make) {
+    anim::AnimationDriver driver;
+    std::vector<std::unique_ptr<anim::ValueAnimation<float>>> animations;
+    animations.reserve(kAnimationCount);
+    for (int i = 0; i < kAnimationCount; ++i) {
+        animations.emplace_back(make(i));
+        animations.back()->set_driver(&driver);
+        animations.back()->SetDuration(kDuration);
+        animations.back()->set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+        animations.back()->Start();
+    }
+    driver.Tick(0L);
+    auto begin = steady_clock::now();
+    for (int frame = 1; frame <= kFrameCount; ++frame) {
+        driver.Tick(frame * kFrameInterval);
+    }
+    return duration_cast<nanoseconds>(steady_clock::now() - begin).count() / double(kAnimationCount) / kFrameCount;
+}
+
+// Time of the write alone, ns per property
+template <typename Write>
+static double MeasureWrite(Write write) {
+    auto begin = steady_clock::now();
+    for (int frame = 1; frame <= kFrameCount; ++frame) {
+        write(float(frame));
+    }
+    return duration_cast<nanoseconds>(steady_clock::now() - begin).count() / double(kAnimationCount) / kFrameCount;
+}
+
+int main() {
+    std::vector<Sprite> sprites(kAnimationCount);
+    using namespace std::placeholders;
+
+    printf("animations: %d, frames: %d\n", kAnimationCount, kFrameCount);
+    printf("driver tick, ns/animation:\n");
+    printf("  subscriber_ std::bind setter: %6.2f\n", MeasureTick([&](int i) {
+        auto animation = new anim::ValueAnimation<float>(0.0f, float(i));
+        animation->subscriber_ = std::bind(&Sprite::set_alpha, &sprites[i], _1);
+        return animation;
+    }));
+    printf("  PointerProperty member:       %6.2f\n", MeasureTick([&](int i) {
+        return new PropertyAnimation<float>({&sprites[i], &Sprite::x}, 0.0f, float(i));
+    }));
+    printf("  SetterProperty:               %6.2f\n", MeasureTick([&](int i) {
+        return new PropertyAnimation<float, SetterProperty<Sprite, float, &Sprite::set_alpha>>(&sprites[i], 0.0f, float(i));
+    }));
+
+    // The write path on its own, without the animations
+    std::vector<std::function<void(const float &)>> subscribers;
+    std::vector<anim::PointerProperty<float>> pointers;
+    for (int i = 0; i < kAnimationCount; ++i) {
+        subscribers.push_back(std::bind(&Sprite::set_alpha, &sprites[i], _1));
+        pointers.emplace_back(&sprites[i], &Sprite::x);
+    }
+    printf("write only, ns/property:\n");
+    printf("  std::function:                %6.2f\n", MeasureWrite([&](float value) {
+        for (auto &subscriber : subscribers) subscriber(value);
+    }));
+    printf("  PointerProperty:              %6.2f\n", MeasureWrite([&](float value) {
+        for (auto &pointer : pointers) pointer.Set(value);
+    }));
+    anim::StridedProperty<float> strided(sprites.data(), sprites.size(), &Sprite::y);
+    printf("  StridedProperty, one value:   %6.2f\n", MeasureWrite([&](float value) { strided.Set(value); }));
+
+    // Tweens with their own values, written to a member of every sprite
+    anim::FloatAnimationBatch batch;
+    batch.Reserve(kAnimationCount);
+    for (int i = 0; i < kAnimationCount; ++i) {
+        batch.Add(0.0f, float(i), kDuration, anim::CurveType::Linear);
+    }
+    std::vector<float> values(kAnimationCount);
+    printf("FloatAnimationBatch, ns/tween:\n");
+    printf("  Advance then copy:            %6.2f\n", MeasureWrite([&](float) {
+        batch.Advance(kFrameInterval, values.data());
+        for (int i = 0; i < kAnimationCount; ++i) sprites[i].x = values[i];
+    }));
+    printf("  strided Advance:              %6.2f\n", MeasureWrite([&](float) {
+        batch.Advance(kFrameInterval, &sprites[0].x, sizeof(Sprite));
+    }));
+    return 0;
+}
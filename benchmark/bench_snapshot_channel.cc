@@ -0,0 +1,63 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "cc_snapshot_channel.hpp"
+
+using namespace std::chrono;
+
+struct Vec4
+{
+    float x, y, z, w;
+};
+
+static const size_t kSlotCount = 10000;
+static const int kFrameCount = 5000;
+
+// The writer publishes kFrameCount frames changing one slot in `changed_every`, while the reader
+// acquires frames and reads every value as fast as it can
+static void Measure(size_t changed_every) {
+    anim::SnapshotChannel<Vec4> channel(kSlotCount);
+    std::atomic<bool> done(false);
+    long acquired = 0, new_frames = 0;
+    float sink = 0.0f;
+
+    std::thread reader([&] {
+        uint64_t last_generation = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            uint64_t generation = 0;
+            const Vec4 *values = channel.Acquire(&generation);
+            ++acquired;
+            if (generation == last_generation) continue;
+            last_generation = generation;
+            ++new_frames;
+            for (size_t slot = 0; slot < kSlotCount; ++slot) sink += values[slot].x + values[slot].w;
+        }
+    });
+
+    auto begin = steady_clock::now();
+    for (int frame = 1; frame <= kFrameCount; ++frame) {
+        const float value = float(frame);
+        for (size_t slot = frame % changed_every; slot < kSlotCount; slot += changed_every) {
+            channel.Write(slot, Vec4{value, value, value, value});
+        }
+        channel.Publish();
+    }
+    const double writer_ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    printf("%5.1f%% changed: %8.0f frames/s published, %6.2f ns/changed value, reader got %ld new frames in %ld acquires%s\n",
+           100.0 / changed_every, kFrameCount / (writer_ns / 1e9),
+           writer_ns / kFrameCount / double(kSlotCount / changed_every),
+           new_frames, acquired, sink == 1.0f ? " " : "");
+}
+
+int main() {
+    printf("slots: %zu Vec4, frames: %d, hardware threads: %u\n", kSlotCount, kFrameCount,
+           std::thread::hardware_concurrency());
+    for (size_t changed_every : {1, 10, 100}) {
+        Measure(changed_every);
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include "cc_static_curve.hpp"
+#include "cc_value_animation.hpp"
+
+using namespace std::chrono;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::StaticCurve;
+using anim::ValueAnimation;
+
+static const size_t kValueCount = 4096;
+static const int kRepeatCount = 500;
+static const long kDuration = 1000L;
+static const int kFrameRepeatCount = 200;
+
+static const char *kCurveNames[] = {
+    "Linear", "InQuad", "OutQuad", "InOutQuad", "OutInQuad", "InCubic", "OutCubic", "InOutCubic", "OutInCubic",
+    "InQuart", "OutQuart", "InOutQuart", "OutInQuart", "InQuint", "OutQuint", "InOutQuint", "OutInQuint",
+    "InSine", "OutSine", "InOutSine", "OutInSine", "InExpo", "OutExpo", "InOutExpo", "OutInExpo",
+    "InCirc", "OutCirc", "InOutCirc", "OutInCirc", "InElastic", "OutElastic", "InOutElastic", "OutInElastic",
+    "InBack", "OutBack", "InOutBack", "OutInBack", "InBounce", "OutBounce", "InOutBounce", "OutInBounce",
+    "InCurve", "OutCurve", "SineCurve", "CosineCurve", "CubicBezier"};
+
+// Keeps the results alive
+static volatile float g_sink = 0.0f;
+
+// Millions of values per second, one ValueForProgress() call per value
+template <typename Curve>
+static double MeasureCurve(const Curve &curve, const std::vector<float> &progress) {
+    float sum = 0.0f;
+    auto begin = steady_clock::now();
+    for (int i = 0; i < kRepeatCount; ++i) {
+        for (size_t j = 0; j < progress.size(); ++j) {
+            sum += curve.ValueForProgress(progress[j]);
+        }
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    g_sink += sum;
+    return double(progress.size()) * kRepeatCount / ns * 1e3;
+}
+
+// Millions of frames per second through ValueAnimation::SetCurrentTime()
+template <typename Animation>
+static double MeasureAnimation(Animation &animation) {
+    float sum = 0.0f;
+    animation.subscriber_ = [&sum](const float &value) { sum += value; };
+    animation.SetDuration(kDuration);
+    auto begin = steady_clock::now();
+    for (int i = 0; i < kFrameRepeatCount; ++i) {
+        for (long time = 0; time < kDuration; ++time) {
+            animation.SetCurrentTime(time);
+        }
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+    g_sink += sum;
+    return double(kDuration) * kFrameRepeatCount / ns * 1e3;
+}
+
+template <CurveType Type>
+static void Run(const std::vector<float> &progress) {
+    const EasingCurve dynamic_curve(Type);
+    const StaticCurve<Type> static_curve;
+    ValueAnimation<float> dynamic_animation({0.0f, 40.0f, 100.0f});
+    ValueAnimation<float, StaticCurve<Type>> static_animation({0.0f, 40.0f, 100.0f});
+    dynamic_animation.set_easing_curve(dynamic_curve);
+    printf("%-14s %10.1f %10.1f %10.2f %10.2f\n", kCurveNames[int(Type)],
+           MeasureCurve(dynamic_curve, progress), MeasureCurve(static_curve, progress),
+           MeasureAnimation(dynamic_animation), MeasureAnimation(static_animation));
+}
+
+template <int... Types>
+static void RunAll(const std::vector<float> &progress, std::integer_sequence<int, Types...>) {
+    const int expand[] = {(Run<CurveType(Types)>(progress), 0)...};
+    (void)expand;
+}
+
+int main() {
+    std::vector<float> progress(kValueCount);
+    for (size_t i = 0; i < kValueCount; ++i) {
+        progress[i] = float(i) / float(kValueCount - 1);
+    }
+    printf("%-14s %10s %10s %10s %10s\n", "", "curve", "curve", "animation", "animation");
+    printf("%-14s %10s %10s %10s %10s\n", "M/s", "dynamic", "static", "dynamic", "static");
+    RunAll(progress, std::make_integer_sequence<int, int(CurveType::Custom)>());
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_property_animation.hpp"
+#include "cc_value_types.hpp"
+
+using namespace std::chrono;
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::Color;
+using anim::PropertyAnimation;
+using anim::Quat;
+using anim::Vec3;
+
+static const int kSpriteCount = 100000;
+static const int kFrameCount = 60;
+static const long kFrameInterval = 16L;
+
+struct Sprite {
+    Vec3 position;
+    Color color;
+    Quat rotation;
+};
+
+// ms per frame of the driver ticking the animations
+static double Measure(AnimationDriver *driver, std::vector<std::unique_ptr<Animation>> &animations) {
+    for (auto &animation : animations) {
+        animation->set_driver(driver);
+        // Longer than the run, every animation is ticked on every frame
+        animation->SetDuration(kFrameInterval * kFrameCount * 4);
+        animation->Start();
+    }
+    driver->Tick(0L);
+    long frame_time = kFrameInterval;
+    auto begin = steady_clock::now();
+    for (int frame = 0; frame < kFrameCount; ++frame) {
+        driver->Tick(frame_time);
+        frame_time += kFrameInterval;
+    }
+    return duration_cast<nanoseconds>(steady_clock::now() - begin).count() / 1e6 / kFrameCount;
+}
+
+static void Report(const char *name, size_t animation_count, double per_component_ms, double vector_ms) {
+    printf("%-18s %12zu %14.2f %12.2f %8.2fx\n", name, animation_count, per_component_ms, vector_ms,
+           per_component_ms / vector_ms);
+}
+
+int main() {
+    std::vector<Sprite> sprites(kSpriteCount);
+    const Vec3 to(100.0f, 50.0f, -20.0f);
+    const Color from_color = Color::FromSrgb(1.0f, 0.5f, 0.0f, 1.0f);
+    const Quat to_rotation = Quat::FromAxisAngle(Vec3(0.0f, 1.0f, 0.0f), 3.0f);
+
+    printf("%d sprites, %d frames\n", kSpriteCount, kFrameCount);
+    printf("%-18s %12s %14s %12s %9s\n", "", "float anims", "float ms/frame", "one ms/frame", "speedup");
+    {
+        AnimationDriver driver;
+        std::vector<std::unique_ptr<Animation>> animations;
+        for (Sprite &sprite : sprites) {
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.position.x, 0.0f, to.x));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.position.y, 0.0f, to.y));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.position.z, 0.0f, to.z));
+        }
+        const double per_component = Measure(&driver, animations);
+        animations.clear();
+        for (Sprite &sprite : sprites) {
+            animations.emplace_back(new PropertyAnimation<Vec3>(&sprite.position, Vec3(), to));
+        }
+        Report("Vec3 position", animations.size() * 3, per_component, Measure(&driver, animations));
+    }
+    {
+        AnimationDriver driver;
+        std::vector<std::unique_ptr<Animation>> animations;
+        for (Sprite &sprite : sprites) {
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.color.r, from_color.r, 0.0f));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.color.g, from_color.g, 0.0f));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.color.b, from_color.b, 0.0f));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.color.a, from_color.a, 0.0f));
+        }
+        const double per_component = Measure(&driver, animations);
+        animations.clear();
+        for (Sprite &sprite : sprites) {
+            animations.emplace_back(new PropertyAnimation<Color>(&sprite.color, from_color, Color()));
+        }
+        Report("Color fade", animations.size() * 4, per_component, Measure(&driver, animations));
+    }
+    {
+        // Per component the rotation is not even normalized, the Quat animation slerps
+        AnimationDriver driver;
+        std::vector<std::unique_ptr<Animation>> animations;
+        for (Sprite &sprite : sprites) {
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.rotation.x, 0.0f, to_rotation.x));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.rotation.y, 0.0f, to_rotation.y));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.rotation.z, 0.0f, to_rotation.z));
+            animations.emplace_back(new PropertyAnimation<float>(&sprite.rotation.w, 1.0f, to_rotation.w));
+        }
+        const double per_component = Measure(&driver, animations);
+        animations.clear();
+        for (Sprite &sprite : sprites) {
+            animations.emplace_back(new PropertyAnimation<Quat>(&sprite.rotation, Quat(), to_rotation));
+        }
+        Report("Quat slerp", animations.size() * 4, per_component, Measure(&driver, animations));
+    }
+    return 0;
+}
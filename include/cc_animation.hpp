@@ -14,30 +14,53 @@
  *    this software without specific prior written permission.
  **/
 #pragma once
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
-#include <list>
+#include <vector>
+
+#include "cc_listener_list.hpp"
 
 namespace anim
 {
     class AnimationListener;
+    class AnimationDriver;
+    class AnimationSet;
+
+    /**
+     * @brief Times and durations of animations. Negative durations stand for infinite ones.
+     *
+     * Animations count time in nanoseconds so that frame intervals such as 4.17 ms at 240 Hz are
+     * not truncated; the overloads taking and returning long are in milliseconds.
+     */
+    using Duration = std::chrono::nanoseconds;
+
     class Animation
     {
+        friend class AnimationDriver;
+        friend class AnimationSet;
     public:
-        enum class Direction
+        enum class Direction : uint8_t
         {
             kForward,
             kReverse,
         };
 
-        enum class State
+        enum class State : uint8_t
         {
             kStopped,
             kRunning,
             kPaused,
         };
 
-        enum class LoopMode
+        /**
+         * @brief How a loop follows the previous one. With kReverse every other loop plays
+         * backwards, so a ValueAnimation goes back and forth between its start and end values.
+         */
+        enum class LoopMode : uint8_t
         {
             kRestart,
             kReverse,
@@ -45,11 +68,18 @@ namespace anim
 
         static const int INFINITE = -1;
 
-        virtual ~Animation() = default;
+        Animation();
+        virtual ~Animation();
 
-        virtual void SetDuration(long duration) = 0;
-        virtual long GetDuration() const = 0;
-        long GetTotalDuration() const;
+        virtual void SetDuration(Duration duration) = 0;
+        void SetDuration(long msecs) { SetDuration(std::chrono::milliseconds(msecs)); }
+        virtual Duration duration() const = 0;
+        long GetDuration() const { return ToMilliseconds(duration()); }
+        /**
+         * @brief The duration of all loops, -1 if it loops forever.
+         */
+        Duration total_duration() const;
+        long GetTotalDuration() const { return ToMilliseconds(total_duration()); }
         void set_direction(Direction direction) { direction_ = direction; }
         Direction direction() const { return direction_; }
         int loop_count() const { return loop_count_; }
@@ -59,43 +89,94 @@ namespace anim
 
         State state() const { return state_; }
 
+        /**
+         * @brief Sets how long a started animation holds its start value before it begins to move,
+         * counted from the first frame after Start(). 0 by default.
+         *
+         * The start notifications are sent by Start(), and the delay is not applied again on Resume().
+         * AnimationDriver::NextDeadline() knows when delayed animations begin. Groups set the time of
+         * their children directly, so the delay only applies to animations ticked by a driver.
+         */
+        void set_start_delay(Duration delay);
+        Duration start_delay() const;
+
+        /**
+         * @brief Sets the driver that ticks this animation while it is running.
+         * The driver must outlive the animation. Passing nullptr selects AnimationDriver::GetInstance().
+         *
+         * @param driver the new driver.
+         */
+        void set_driver(AnimationDriver *driver);
+        AnimationDriver *driver() const;
+        /**
+         * @brief The group driving this animation, nullptr when it is driven by its driver.
+         */
+        AnimationSet *group() const;
+
         virtual void Start();
         virtual void Stop();
         virtual void Cancel();
         virtual void Pause();
         virtual void Resume();
 
-        void SetStateListener(std::function<void(State)> listener) {
-            state_listener_ = listener;
-        }
+        void SetStateListener(std::function<void(State)> listener);
+        std::function<void(State)> GetStateListener() const;
 
-        std::function<void(State)> GetStateListener() const {
-            return state_listener_;
-        }
-
-        void AddAnimationListener(const std::shared_ptr<AnimationListener>& listener) {
-            if (nullptr == listeners_) {
-                listeners_ = decltype(listeners_)(new std::list<std::shared_ptr<AnimationListener>>());
-            }
-            listeners_->push_back(listener);
-        }
+        /**
+         * @brief Adds a listener, which is not owned and must be removed before it is destroyed.
+         * Listeners are kept with the cold configuration, the first one allocates it and up to two
+         * are stored without allocating more.
+         */
+        void AddAnimationListener(AnimationListener *listener);
+        /**
+         * @brief Removes a listener, also from within one of its callbacks.
+         */
+        void RemoveAnimationListener(AnimationListener *listener);
 
-        void RemoveAnimationListener(const std::shared_ptr<AnimationListener>& listener) {
-            if (listeners_) {
-                listeners_->remove_if([&listener](const std::shared_ptr<AnimationListener>& n) -> bool { return n == listener; });
-            }
-        }
+        void SetCurrentTime(Duration time);
+        void SetCurrentTime(long msecs) { SetCurrentTime(Duration(std::chrono::milliseconds(msecs))); }
+        /**
+         * @brief The time within the current loop.
+         */
+        Duration current_time() const { return current_time_; }
+        long GetCurrentTime() const { return ToMilliseconds(current_time_); }
 
-        void SetCurrentTime(long msecs);
-        long GetCurrentTime() const { return current_time_; }
+        /**
+         * @brief A loop and the time within it.
+         */
+        struct LoopTime
+        {
+            Duration time;
+            int loop;
+        };
+        /**
+         * @brief The loop and loop time the driver sets elapsed after the first frame of a started
+         * animation, the start delay aside, without changing the animation.
+         *
+         * Only the configuration is read (duration, direction, loops), not the playback state, so it
+         * may run on any thread, even while the animation is ticked, as long as nothing reconfigures it.
+         */
+        LoopTime LoopTimeAt(Duration elapsed) const;
+        /**
+         * @brief LoopTimeAt() for count times first + i * interval, reading the configuration once.
+         */
+        void LoopTimesAt(Duration first, Duration interval, size_t count, LoopTime *out) const;
 
         /**
          * @brief Processes a frame of the animation, adjusting the start time if needed.
          * 
          * @param frame_time  The frame time.
-         * @return true  if the animation has ended.
          */
-        void UpdateAnimationFrame(long frame_time);
+        void UpdateAnimationFrame(Duration frame_time);
+        void UpdateAnimationFrame(long frame_time) { UpdateAnimationFrame(Duration(std::chrono::milliseconds(frame_time))); }
+
+        /**
+         * @brief Truncates to milliseconds, keeping negative durations at -1.
+         */
+        static long ToMilliseconds(Duration duration) {
+            if (duration < Duration::zero()) return -1L;
+            return long(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+        }
 
     protected:
         void SetState(State state);
@@ -104,7 +185,7 @@ namespace anim
          *
          * @param current_time current time in milliseconds.
          */
-        virtual void UpdateCurrentTime(long current_time) = 0;
+        virtual void UpdateCurrentTime(Duration current_time) = 0;
 
         /**
          * @brief This virtual function is called by Animation when the direction of the animation
@@ -121,24 +202,82 @@ namespace anim
          * @param old_state the old state.
          */
         virtual void UpdateState(State new_state, State old_state);
+        /**
+         * @brief Splits a time in [0, total_duration()] into a loop and the time within it, see
+         * SetCurrentTime().
+         */
+        LoopTime ToLoopTime(Duration time) const { return ToLoopTime(time, duration()); }
+        LoopTime ToLoopTime(Duration time, Duration duration) const;
+        // total_duration() for a given duration()
+        Duration TotalDuration(Duration duration) const;
+        void NotifyListeners(void (AnimationListener::*callback)(Animation &));
 
-        std::unique_ptr<std::list<std::shared_ptr<AnimationListener>>> listeners_ = nullptr;
-        bool paused_ = false;
+        // Notifications raised while a worker of the driver's parallel tick updates the animation
+        enum PendingNotification : uint16_t
+        {
+            kPendingUnregister = 1 << 0,
+            kPendingState = 1 << 1,
+            kPendingStart = 1 << 2,
+            kPendingValueUpdate = 1 << 3,
+            kPendingValueChange = 1 << 4,
+            kPendingRepeat = 1 << 5,
+            kPendingPause = 1 << 6,
+            kPendingResume = 1 << 7,
+            kPendingCancel = 1 << 8,
+            kPendingEnd = 1 << 9,
+        };
+        /**
+         * @brief Records a notification to be delivered once the parallel tick is over, on the thread
+         * owning the driver.
+         *
+         * @return false if no parallel tick is running on this thread, the caller notifies right away.
+         */
+        bool DeferNotification(uint16_t notification);
+        /**
+         * @brief Delivers the deferred notifications, overrides deliver their own ones then call this.
+         */
+        virtual void DeliverPendingNotifications();
+        /**
+         * @brief Starts (with a list) or stops (with nullptr) deferring the notifications raised on
+         * the calling thread. Animations are appended to the list on their first deferred notification.
+         */
+        static void SetDeferredAnimations(std::vector<Animation *> *animations);
+
+        // What a tick reads and writes, in the first cache line with the vtable pointer and cold_:
+        // 64 bytes on 64-bit targets, so the hot fields of a derived class follow right after
+        Duration current_time_{0};
+        Duration total_current_time_{0};
+        // -1 until the first frame, which sets the start time
+        Duration last_update_time_{-1};
+        AnimationDriver *driver_ = nullptr;
+        int32_t loop_count_ = 1;
+        int32_t current_loop_ = 0;
+        int32_t driver_slot_ = -1;
+        // Written by the thread ticking the animation only, like delay_pending_ sharing its bytes
+        uint16_t pending_notifications_ : 15;
+        // Whether the next first frame applies the start delay, i.e. the animation was started and not resumed
+        uint16_t delay_pending_ : 1;
         State state_ = State::kStopped;
     // private:
-        Direction direction_ = Direction::kForward;
-        std::function<void(State)> state_listener_;
-        LoopMode loop_mode_ = LoopMode::kRestart;
-        long start_time_ = 0L;
-        long pause_time_ = 0L;
-        long last_update_time_ = -1L;
-        long current_time_ = 0L;
-        long total_current_time_ = 0L;
-        int loop_count_ = 1;
-        int current_loop_ = 0;
-        bool resumed_ = false;
+        // One byte for both, only written by their setters so Evaluate() may read them while
+        // another thread ticks. Set by the constructor
+        Direction direction_ : 1;
+        LoopMode loop_mode_ : 1;
+
+    private:
+        // The configuration few animations set, allocated by the first setter
+        struct ColdData;
+        ColdData &Cold();
+        void set_group(AnimationSet *group);
+
+        std::unique_ptr<ColdData> cold_;
     };
 
+    /**
+     * @brief Receives the notifications of the animations it is added to. Start is sent when a
+     * stopped animation starts running, End when it stops, after Cancel if it was cancelled, and
+     * Repeat each time a new loop begins.
+     */
     struct AnimationListener {
         virtual void OnAnimationStart(Animation &animation) {}
         virtual void OnAnimationEnd(Animation &animation) {}
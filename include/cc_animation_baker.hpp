@@ -0,0 +1,87 @@
+/**
+ * @file cc_animation_baker.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "cc_value_animation.hpp"
+
+namespace anim
+{
+    class WorkerPool;
+
+    /**
+     * @brief Samples animations at a fixed rate into caller-provided buffers, e.g. for video
+     * export, without playing them.
+     *
+     * Frame i of an animation is its ValueAnimation::Evaluate() value at i * interval after its
+     * first frame. The animations are only read, they may be played meanwhile but not reconfigured.
+     */
+    class AnimationBaker
+    {
+    public:
+        AnimationBaker();
+        AnimationBaker(const AnimationBaker &) = delete;
+        AnimationBaker &operator=(const AnimationBaker &) = delete;
+        ~AnimationBaker();
+
+        /**
+         * @brief Sets the number of threads baking, including the calling one. 1 by default, which
+         * bakes on the calling thread only.
+         */
+        void set_thread_count(int count);
+        int thread_count() const;
+
+        /**
+         * @brief The number of frames covering the total duration of an animation at an interval,
+         * both ends included, 0 for animations looping forever.
+         */
+        static size_t FrameCount(const Animation &animation, Duration interval);
+
+        /**
+         * @brief Bakes frame_count frames of one animation into out, split in chunks across the threads.
+         */
+        template <typename T, typename Curve>
+        void Bake(const ValueAnimation<T, Curve> &animation, Duration interval, size_t frame_count, T *out) {
+            const size_t chunk_count = (frame_count + kFramesPerChunk - 1) / kFramesPerChunk;
+            Run(chunk_count, [&](size_t chunk) {
+                const size_t begin = chunk * kFramesPerChunk;
+                const size_t end = (frame_count - begin < kFramesPerChunk) ? frame_count : begin + kFramesPerChunk;
+                animation.EvaluateFrames(interval * long(begin), interval, end - begin, out + begin);
+            });
+        }
+        /**
+         * @brief Bakes frame_count frames of count animations, animation a into
+         * out[a * frame_count, (a + 1) * frame_count), one animation per task.
+         */
+        template <typename T, typename Curve>
+        void Bake(const ValueAnimation<T, Curve> *const *animations, size_t count, Duration interval,
+                  size_t frame_count, T *out) {
+            Run(count, [&](size_t a) {
+                animations[a]->EvaluateFrames(Duration::zero(), interval, frame_count, out + a * frame_count);
+            });
+        }
+
+    private:
+        static const size_t kFramesPerChunk = 1024;
+
+        // Runs task(i) for every i in [0, count), on the pool if there is one
+        void Run(size_t count, const std::function<void(size_t)> &task);
+
+        std::unique_ptr<WorkerPool> pool_;
+    };
+} // namespace anim
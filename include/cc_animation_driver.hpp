@@ -1,6 +1,224 @@
+/**
+ * @file cc_animation_driver.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
 #pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "cc_animation.hpp"
 
 namespace anim
 {
+    class FrameLog;
+    class WorkerPool;
+    template <typename T> class CommandQueue;
+
+    /**
+     * @brief Notified at the beginning of every tick of the drivers it is added to, before the
+     * posted commands run and before any animation is updated, see AnimationDriver::AddTickObserver().
+     */
+    class TickObserver
+    {
+    public:
+        virtual ~TickObserver() = default;
+        virtual void OnTickBegin(Duration frame_time) = 0;
+        /**
+         * @brief Notified when an animation of the driver ends, after its listeners and on the
+         * driver's thread, so owners of many animations don't have to add a listener to each one.
+         */
+        virtual void OnAnimationEnd(Animation &) {}
+    };
+
+    /**
+     * @brief Drives every running animation from a single frame loop.
+     *
+     * Animations register themselves when they enter State::kRunning and unregister when they
+     * stop, pause or are destroyed, so the driver only ever touches running animations. They are
+     * kept in a dense array; removals during a tick only clear the slot and the array is compacted
+     * once the tick is over, so finishing an animation never invalidates the iteration.
+     *
+     * With more than one thread, the running animations are split in chunks which are updated by
+     * a pool of workers, see set_thread_count(). Subscribers, listeners and state changes raised
+     * meanwhile are deferred and delivered on the ticking thread once all chunks are done, in the
+     * order the animations are registered, so callbacks behave the same as with one thread.
+     *
+     * The driver and its animations belong to the thread calling Tick(). Other threads control
+     * animations through Post(), which never blocks; the commands run at the beginning of the
+     * next tick.
+     *
+     * Rather than ticking in a loop, an event loop can sleep until NextDeadline() and be woken by
+     * the wakeup callback when new work arrives, so an idle driver costs no CPU at all, see
+     * AnimationTimer for a timerfd doing both.
+     */
+    class AnimationDriver
+    {
+    public:
+        enum class Command
+        {
+            kStart,
+            kStop,
+            kPause,
+            kResume,
+            kCancel,
+        };
+
+        AnimationDriver();
+        AnimationDriver(const AnimationDriver &) = delete;
+        AnimationDriver &operator=(const AnimationDriver &) = delete;
+        ~AnimationDriver();
+
+        /**
+         * @brief The driver used by animations which have no driver set explicitly.
+         * There is one per thread.
+         */
+        static AnimationDriver &GetInstance();
+
+        /**
+         * @brief Current time of the monotonic clock used by Tick().
+         */
+        static Duration Clock();
+        /**
+         * @brief Clock() in milliseconds.
+         */
+        static long Now();
+
+        void RegisterAnimation(Animation *animation);
+        void UnregisterAnimation(Animation *animation);
+        /**
+         * @brief Passes the end of an animation on to the tick observers, called by the animation.
+         */
+        void NotifyAnimationEnd(Animation *animation);
+
+        /**
+         * @brief Samples the clock once and advances every running animation to that time.
+         */
+        void Tick();
+
+        /**
+         * @brief Advances every running animation to the given frame time.
+         *
+         * Animations registered while ticking are picked up from the next frame on.
+         *
+         * @param frame_time The frame time, e.g. the presentation time of the frame.
+         */
+        void Tick(Duration frame_time);
+        /**
+         * @param frame_time The frame time in milliseconds.
+         */
+        void Tick(long frame_time) { Tick(Duration(std::chrono::milliseconds(frame_time))); }
+
+        /**
+         * @brief Queues a command for the animation, run by the next Tick() before any animation is
+         * updated. Can be called from any thread without locking, the commands posted by a thread
+         * run in the order they were posted.
+         *
+         * The animation must be driven by this driver and must outlive the command.
+         */
+        void Post(Animation *animation, Command command);
+        /**
+         * @brief Runs the queued commands now, Tick() calls this first.
+         * Only from the thread ticking the driver.
+         */
+        void RunPostedCommands();
+
+        /**
+         * @brief Calls the observer at the beginning of every tick, in the order observers were
+         * added. The observer is not owned and must be removed before it is destroyed, observers
+         * must not be added or removed from OnTickBegin() or OnAnimationEnd().
+         */
+        void AddTickObserver(TickObserver *observer);
+        void RemoveTickObserver(TickObserver *observer);
+
+        /**
+         * @brief Clears the log at the beginning of every tick, so after a tick it holds the changes
+         * of that frame only: a FrameLog is a TickObserver clearing itself. The log is not owned and
+         * must be removed before it is destroyed.
+         */
+        void AddChangeLog(FrameLog *log);
+        void RemoveChangeLog(FrameLog *log);
+
+        /**
+         * @brief The frame time of the next tick which would change anything: Duration::max() when
+         * idle, the start of the earliest delayed animation when all are delayed, and one frame
+         * interval after the last tick otherwise. A deadline not after the current time means tick
+         * right away, e.g. Duration::min() when commands were posted or before the first tick.
+         */
+        Duration NextDeadline() const;
+        /**
+         * @brief The interval between frames while animations are running, 1/60 s by default.
+         */
+        void set_frame_interval(Duration interval) { frame_interval_ = interval; }
+        Duration frame_interval() const { return frame_interval_; }
+        /**
+         * @brief Sets a function called when NextDeadline() may have become earlier: when an
+         * animation registers outside a tick, at most once between two ticks, and on every Post().
+         *
+         * As Post() calls it on the posting thread it must be thread-safe, e.g. write to an eventfd,
+         * and must be set before other threads post.
+         */
+        void set_wakeup_callback(std::function<void()> callback) { wakeup_ = std::move(callback); }
+        /**
+         * @brief Whether commands were posted since the last tick. Only from the thread ticking the
+         * driver, a post in progress may be missed.
+         */
+        bool HasPostedCommands() const;
+
+        size_t animation_count() const { return animations_.size() - removed_count_; }
+        bool IsIdle() const { return 0 == animation_count(); }
+
+        /**
+         * @brief Sets how many threads update the animations, including the one calling Tick().
+         * 1, the default, updates them serially without any worker thread.
+         *
+         * Animations updated in parallel must not share state other than through their callbacks,
+         * which are deferred. A group and its children count as one animation.
+         */
+        void set_thread_count(int count);
+        int thread_count() const;
+        /**
+         * @brief Sets the number of animations per chunk of the parallel tick, 256 by default.
+         */
+        void set_chunk_size(size_t size) { chunk_size_ = size > 0 ? size : 1; }
+        size_t chunk_size() const { return chunk_size_; }
+
+    private:
+        void Compact();
+        void TickParallel(Duration frame_time);
+
+        struct PostedCommand
+        {
+            Animation *animation;
+            Command command;
+        };
 
-}
\ No newline at end of file
+        std::unique_ptr<CommandQueue<PostedCommand>> commands_;
+        std::unique_ptr<WorkerPool> pool_;
+        size_t chunk_size_ = 256;
+        // Animations with deferred notifications, per chunk
+        std::vector<std::vector<Animation *>> deferred_;
+        std::vector<TickObserver *> tick_observers_;
+        std::vector<Animation *> animations_;
+        size_t removed_count_ = 0;
+        bool ticking_ = false;
+        std::function<void()> wakeup_;
+        // Whether wakeup_ was called for a registration since the last tick
+        bool woken_ = false;
+        Duration frame_interval_{1000000000L / 60};
+        // Duration::min() before the first tick
+        Duration last_frame_time_ = Duration::min();
+    };
+} // namespace anim
@@ -0,0 +1,191 @@
+/**
+ * @file cc_animation_pool.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cc_animation.hpp"
+#include "cc_animation_driver.hpp"
+
+namespace anim
+{
+    /**
+     * @brief Owns short-lived animations of type A, e.g. hover effects and ripples, which are
+     * launched and forgotten: each one is destroyed once it ends and its slot is reused.
+     *
+     * Slots are allocated in chunks which are kept until the pool is destroyed, so once the pool
+     * has grown to the number of animations alive at once, launching and recycling allocate
+     * nothing. Animations built on a shared KeyframeClip allocate nothing either, which makes
+     * steady-state churn free of global operator new calls.
+     *
+     * Animations are recycled at the beginning of the driver's next tick after they end, never
+     * from within their own notifications. One restarted before that is kept. The pointer returned
+     * by Launch() must not be used after the animation ended. The pool is used on the driver's thread.
+     */
+    template <typename A>
+    class AnimationPool final : private TickObserver
+    {
+        static_assert(std::is_base_of<Animation, A>::value, "Pooled types must be animations");
+
+    public:
+        static const size_t kChunkSize = 64;
+
+        /**
+         * @param driver The driver of the animations, nullptr for AnimationDriver::GetInstance(). It
+         * must outlive the pool.
+         */
+        explicit AnimationPool(AnimationDriver *driver = nullptr)
+            : driver_(driver ? driver : &AnimationDriver::GetInstance()) {
+            driver_->AddTickObserver(static_cast<TickObserver *>(this));
+        }
+        AnimationPool(const AnimationPool &) = delete;
+        AnimationPool &operator=(const AnimationPool &) = delete;
+        ~AnimationPool() {
+            driver_->RemoveTickObserver(static_cast<TickObserver *>(this));
+            for (auto &chunk : chunks_) {
+                for (size_t i = 0; i < kChunkSize; ++i) {
+                    if (chunk[i].live) Destroy(&chunk[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Creates an animation owned by the pool, to be configured and started by the
+         * caller. It is recycled once it ends, or when the pool is destroyed if it never starts.
+         */
+        template <typename... Args>
+        A *Acquire(Args &&... args) {
+            if (nullptr == free_) Grow();
+            Slot *slot = free_;
+            free_ = slot->next;
+            A *animation = new (&slot->storage) A(std::forward<Args>(args)...);
+            slot->live = true;
+            slot->ended = false;
+            ++live_count_;
+            // Its end is reported by the driver, a listener would allocate the animation's cold data
+            animation->set_driver(driver_);
+            return animation;
+        }
+        /**
+         * @brief Acquire() then Start().
+         */
+        template <typename... Args>
+        A *Launch(Args &&... args) {
+            A *animation = Acquire(std::forward<Args>(args)...);
+            animation->Start();
+            return animation;
+        }
+
+        /**
+         * @brief Grows the pool to hold count animations at once.
+         */
+        void Reserve(size_t count) {
+            while (capacity() < count) Grow();
+        }
+        size_t capacity() const { return chunks_.size() * kChunkSize; }
+        /**
+         * @brief The number of animations not recycled yet.
+         */
+        size_t live_count() const { return live_count_; }
+
+        /**
+         * @brief Recycles the animations which ended, called by the driver before every tick.
+         */
+        void Recycle() {
+            Slot *slot = ended_;
+            ended_ = nullptr;
+            while (slot) {
+                Slot *next = slot->next;
+                slot->ended = false;
+                // Restarted since it ended
+                if (Animation::State::kStopped != Get(slot)->state()) {
+                    slot = next;
+                    continue;
+                }
+                Destroy(slot);
+                slot = next;
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            typename std::aligned_storage<sizeof(A), alignof(A)>::type storage;
+            // The next free slot, or the next ended one
+            Slot *next;
+            bool live;
+            bool ended;
+        };
+
+        void OnTickBegin(Duration) override { Recycle(); }
+
+        static A *Get(Slot *slot) { return reinterpret_cast<A *>(&slot->storage); }
+
+        // The driver reports the end of every animation it drives, not only of the pooled ones
+        void OnAnimationEnd(Animation &animation) override {
+            Slot *slot = Find(animation);
+            if (nullptr == slot || slot->ended) return;
+            slot->ended = true;
+            slot->next = ended_;
+            ended_ = slot;
+        }
+
+        // The live slot holding the animation, nullptr if it is not one of the pool's
+        Slot *Find(Animation &animation) const {
+            const char *address = reinterpret_cast<const char *>(&animation);
+            for (const auto &chunk : chunks_) {
+                const char *begin = reinterpret_cast<const char *>(chunk.get());
+                if (std::less<const char *>()(address, begin)
+                    || !std::less<const char *>()(address, begin + kChunkSize * sizeof(Slot))) {
+                    continue;
+                }
+                Slot *slot = &chunk[size_t(address - begin) / sizeof(Slot)];
+                return (slot->live && static_cast<Animation *>(Get(slot)) == &animation) ? slot : nullptr;
+            }
+            return nullptr;
+        }
+
+        void Grow() {
+            std::unique_ptr<Slot[]> chunk(new Slot[kChunkSize]);
+            for (size_t i = kChunkSize; i-- > 0;) {
+                chunk[i].live = false;
+                chunk[i].ended = false;
+                chunk[i].next = free_;
+                free_ = &chunk[i];
+            }
+            chunks_.push_back(std::move(chunk));
+        }
+
+        void Destroy(Slot *slot) {
+            Get(slot)->~A();
+            slot->live = false;
+            slot->next = free_;
+            free_ = slot;
+            --live_count_;
+        }
+
+        AnimationDriver *driver_;
+        std::vector<std::unique_ptr<Slot[]>> chunks_;
+        Slot *free_ = nullptr;
+        Slot *ended_ = nullptr;
+        size_t live_count_ = 0;
+    };
+} // namespace anim
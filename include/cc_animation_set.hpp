@@ -14,11 +14,93 @@
  *    this software without specific prior written permission.
  **/
 #pragma once
+#include <cstddef>
+#include <vector>
 
 #include "cc_animation.hpp"
 
 namespace anim {
+    /**
+     * @brief Plays child animations together or one after another, as a single animation.
+     *
+     * Groups nest, and loop and run in reverse like any animation. The children are not owned, they
+     * must outlive the group or be removed from it, and are driven by the group instead of their
+     * driver while they are in it.
+     *
+     * When the group starts, its children are flattened into an array of [start, end) offsets
+     * sorted by both start and end, which holds for sequential and parallel groups alike. Each
+     * update binary-searches that array, so it only visits the children active at the new time,
+     * plus the children whose interval it moved past, which are settled on their end (or start,
+     * when moving backwards). A seek costs O(log n + active + passed).
+     */
     class AnimationSet : public Animation {
+    public:
+        enum class Ordering
+        {
+            kParallel,
+            kSequential,
+        };
 
+        explicit AnimationSet(Ordering ordering = Ordering::kParallel) : ordering_(ordering) {}
+        ~AnimationSet() override;
+
+        Ordering ordering() const { return ordering_; }
+        void set_ordering(Ordering ordering) { ordering_ = ordering; timeline_dirty_ = true; }
+
+        /**
+         * @brief Appends a child, removing it from its previous group if any.
+         * Changes to the children take effect when the group next starts.
+         */
+        void AddAnimation(Animation *animation);
+        void RemoveAnimation(Animation *animation);
+        void ClearAnimations();
+        size_t animation_count() const { return animations_.size(); }
+        Animation *animation_at(size_t index) const { return animations_[index]; }
+
+        // The duration follows from the children
+        using Animation::SetDuration;
+        void SetDuration(Duration) override {}
+        /**
+         * @brief The duration of one loop: the sum of the children's total durations when sequential,
+         * the longest when parallel, -1 if a child loops forever.
+         */
+        Duration duration() const override;
+
+        void Start() override;
+        void Stop() override;
+        void Cancel() override;
+        void Pause() override;
+        void Resume() override;
+
+    protected:
+        void UpdateCurrentTime(Duration current_time) override;
+
+    private:
+        struct TimelineEntry
+        {
+            Duration start;
+            // kForever for children that loop forever
+            Duration end;
+            Animation *animation;
+        };
+        static const Duration kForever;
+
+        Duration ComputeDuration() const;
+        // Where a loop time falls on the timeline, mirrored on the odd loops of LoopMode::kReverse
+        Duration TimelineTime(Duration time, int loop) const {
+            return (LoopMode::kReverse == loop_mode_ && (loop & 1)) ? duration_ - time : time;
+        }
+        void Flatten();
+        void Move(Duration from, Duration to);
+
+        Ordering ordering_;
+        std::vector<Animation *> animations_;
+        std::vector<TimelineEntry> timeline_;
+        Duration duration_{0};
+        bool timeline_dirty_ = true;
+        // Timeline time and loop of the last update, -1 when the children are not settled yet
+        Duration last_time_{-1};
+        int last_loop_ = 0;
+        bool restarted_ = false;
     };
 }
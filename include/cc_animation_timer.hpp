@@ -0,0 +1,64 @@
+/**
+ * @file cc_animation_timer.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+
+#include "cc_animation_driver.hpp"
+
+namespace anim
+{
+#if defined(__linux__)
+    /**
+     * @brief Ticks an AnimationDriver from an epoll (or poll, select) loop through a Linux timerfd.
+     *
+     * The timer is armed for the driver's NextDeadline() and disarmed when the driver is idle, so
+     * an idle process sleeps in epoll_wait() instead of waking up every frame. Starting an
+     * animation or posting a command fires it right away through the driver's wakeup callback.
+     *
+     * Add fd() to the loop for readability and call OnReadable() when it is readable. Frames are
+     * ticked with AnimationDriver::Clock(), the monotonic clock the timer runs on.
+     */
+    class AnimationTimer
+    {
+    public:
+        /**
+         * @param driver Must outlive the timer, its wakeup callback is replaced.
+         */
+        explicit AnimationTimer(AnimationDriver *driver);
+        AnimationTimer(const AnimationTimer &) = delete;
+        AnimationTimer &operator=(const AnimationTimer &) = delete;
+        ~AnimationTimer();
+
+        /**
+         * @brief The timerfd, -1 if it could not be created.
+         */
+        int fd() const { return fd_; }
+        bool IsValid() const { return fd_ >= 0; }
+
+        /**
+         * @brief Ticks the driver if the timer expired, then arms it for the next deadline.
+         */
+        void OnReadable();
+        /**
+         * @brief Arms the timer for the driver's next deadline, after changes made without a tick.
+         */
+        void Arm();
+
+    private:
+        AnimationDriver *driver_;
+        int fd_;
+    };
+#endif
+} // namespace anim
@@ -0,0 +1,68 @@
+/**
+ * @file cc_change_log.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cc_animation_driver.hpp"
+
+namespace anim
+{
+    /**
+     * @brief A log cleared by AnimationDriver at the beginning of every tick, see
+     * AnimationDriver::AddChangeLog().
+     */
+    class FrameLog : public TickObserver
+    {
+    public:
+        virtual void Clear() = 0;
+        void OnTickBegin(Duration) final { Clear(); }
+    };
+
+    /**
+     * @brief The values changed during a frame, one (id, value) entry per animation whose value
+     * changed, in the order they changed.
+     *
+     * Animations append to it with ValueAnimation::set_change_log(). Once the driver's tick is
+     * over, the entries are a contiguous array which can be applied in one pass instead of one
+     * subscriber call per value. Animations whose value did not change add nothing.
+     */
+    template <typename T>
+    class ChangeLog : public FrameLog
+    {
+    public:
+        struct Entry
+        {
+            uint32_t id;
+            T value;
+        };
+
+        void Append(uint32_t id, const T &value) { entries_.push_back(Entry{id, value}); }
+        void Clear() override { entries_.clear(); }
+        void Reserve(size_t count) { entries_.reserve(count); }
+
+        const Entry *data() const { return entries_.data(); }
+        size_t size() const { return entries_.size(); }
+        bool empty() const { return entries_.empty(); }
+        const Entry *begin() const { return entries_.data(); }
+        const Entry *end() const { return entries_.data() + entries_.size(); }
+        const Entry &operator[](size_t index) const { return entries_[index]; }
+
+    private:
+        std::vector<Entry> entries_;
+    };
+} // namespace anim
@@ -0,0 +1,207 @@
+/**
+ * @file cc_clip_file.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "cc_keyframe.hpp"
+
+namespace anim
+{
+    /**
+     * @brief Identifies the value type of a baked clip, so a clip is never read as another type.
+     *
+     * Defined for arithmetic types. Other trivially copyable types, e.g. vectors or colors, can be
+     * baked by specializing it with a kTypeId of at least 0x10000.
+     */
+    template <typename T, typename Enable = void>
+    struct ClipValueTraits;
+
+    template <typename T>
+    struct ClipValueTraits<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+        static const uint32_t kTypeId = (std::is_floating_point<T>::value ? 0x100u
+                                         : std::is_signed<T>::value ? 0x200u : 0x300u) | uint32_t(sizeof(T));
+    };
+
+    /**
+     * @brief A read-only file of named baked clips, written by ClipWriter.
+     *
+     * Open() maps the file, checks its header and directory and builds the BakedClipIndex of every
+     * clip from the directory, the keyframes and curves are paged in when animations evaluate them.
+     * The BakedClip views returned by GetClip() point into the mapping and the file's indexes, they
+     * are valid until the file is closed or destroyed.
+     *
+     * The format is versioned by kVersion and stored in the byte order of the machine baking it,
+     * files of another version or byte order are rejected.
+     */
+    class ClipFile
+    {
+    public:
+        static const uint32_t kVersion = 2;
+
+        ClipFile() = default;
+        ClipFile(const ClipFile &) = delete;
+        ClipFile &operator=(const ClipFile &) = delete;
+        ~ClipFile() { Close(); }
+
+        /**
+         * @brief Maps a clip file, or reads it where mapping is not available.
+         *
+         * @return false, leaving the file closed, if it can't be read or is not a valid clip file.
+         */
+        bool Open(const std::string &path);
+        /**
+         * @brief Uses clips already in memory, e.g. embedded in the executable. The data is not
+         * copied and must outlive the file, it must be aligned to 16 bytes.
+         */
+        bool OpenMemory(const void *data, size_t size);
+        void Close();
+        bool IsOpen() const { return nullptr != data_; }
+        /**
+         * @brief Whether the clips are read from a mapping of the file rather than a copy.
+         */
+        bool is_mapped() const { return mapped_; }
+
+        size_t clip_count() const { return clip_count_; }
+        const char *clip_name(size_t index) const;
+        /**
+         * @brief The index of the clip with that name, -1 if there is none.
+         *
+         * Looked up in the hash table of the names stored in the file, so it compares a single
+         * name in most cases whatever the number of clips.
+         */
+        long FindClip(const char *name) const;
+
+        /**
+         * @brief Gets a view of a clip.
+         *
+         * @return false, leaving clip untouched, if there is no such clip or its values are not of type T.
+         */
+        template <typename T>
+        bool GetClip(size_t index, BakedClip<T> *clip) const {
+            BakedClip<void> data;
+            if (!GetClipData(index, ClipValueTraits<T>::kTypeId, sizeof(T), alignof(T), &data)) return false;
+            clip->progress = data.progress;
+            clip->values = static_cast<const T *>(data.values);
+            clip->count = data.count;
+            clip->duration = data.duration;
+            clip->index = data.index;
+            return true;
+        }
+        template <typename T>
+        bool GetClip(const char *name, BakedClip<T> *clip) const {
+            const long index = FindClip(name);
+            return index >= 0 && GetClip(size_t(index), clip);
+        }
+
+    private:
+        bool Validate();
+        bool GetClipData(size_t index, uint32_t value_type, size_t value_size, size_t value_align,
+                         BakedClip<void> *clip) const;
+
+        const char *data_ = nullptr;
+        size_t size_ = 0;
+        bool mapped_ = false;
+        // Holds the file where it can't be mapped
+        std::vector<char> buffer_;
+        size_t clip_count_ = 0;
+        const void *directory_ = nullptr;
+        const void *name_slots_ = nullptr;
+        uint32_t name_slot_count_ = 0;
+        // One per clip, so creating an animation from a clip allocates nothing
+        std::unique_ptr<BakedClipIndex[]> indexes_;
+    };
+
+    /**
+     * @brief Bakes keyframes into the format read by ClipFile.
+     */
+    class ClipWriter
+    {
+    public:
+        /**
+         * @brief Adds a clip, whose keyframes are sorted like those of a ValueAnimation.
+         *
+         * @return false, adding nothing, if the name is already used, there are fewer than 2
+         * keyframes or one of their curves is Custom, which has no record.
+         */
+        template <typename T>
+        bool AddClip(const std::string &name, std::vector<Keyframe<T>> keyframes, std::chrono::nanoseconds duration) {
+            static_assert(std::is_trivially_copyable<T>::value, "Baked values must be trivially copyable");
+            if (keyframes.size() < 2) return false;
+            std::stable_sort(keyframes.begin(), keyframes.end());
+            PendingClip clip;
+            clip.name = name;
+            clip.value_type = ClipValueTraits<T>::kTypeId;
+            clip.value_size = uint32_t(sizeof(T));
+            clip.duration_ns = duration.count();
+            clip.values.resize(keyframes.size() * sizeof(T));
+            bool linear = true;
+            for (size_t i = 0; i < keyframes.size(); ++i) {
+                const Keyframe<T> &keyframe = keyframes[i];
+                clip.progress.push_back(keyframe.progress());
+                std::memcpy(&clip.values[i * sizeof(T)], &keyframe.value(), sizeof(T));
+                if (i + 1 == keyframes.size()) break;
+                CurveRecord record;
+                if (!keyframe.easing_curve().ToRecord(&record)) return false;
+                linear = linear && int32_t(CurveType::Linear) == record.type;
+                clip.curves.push_back(record);
+            }
+            if (linear) clip.curves.clear();
+            KeyframeIndex index;
+            index.Build(keyframes);
+            clip.buckets.assign(index.buckets(), index.buckets() + index.bucket_count());
+            clip.bucket_start = index.start();
+            clip.bucket_scale = index.scale();
+            return AddPendingClip(std::move(clip));
+        }
+
+        size_t clip_count() const { return clips_.size(); }
+        /**
+         * @brief The file holding every clip added so far.
+         */
+        std::vector<char> Serialize() const;
+        bool Write(const std::string &path) const;
+
+    private:
+        struct PendingClip
+        {
+            std::string name;
+            uint32_t value_type = 0;
+            uint32_t value_size = 0;
+            int64_t duration_ns = 0;
+            std::vector<float> progress;
+            std::vector<char> values;
+            std::vector<CurveRecord> curves;
+            std::vector<uint32_t> buckets;
+            float bucket_start = 0.0f;
+            float bucket_scale = 0.0f;
+        };
+
+        bool AddPendingClip(PendingClip clip);
+
+        std::vector<PendingClip> clips_;
+        std::set<std::string> names_;
+    };
+} // namespace anim
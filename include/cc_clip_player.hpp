@@ -0,0 +1,107 @@
+/**
+ * @file cc_clip_player.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <cstdint>
+#include <utility>
+
+#include "cc_keyframe_clip.hpp"
+#include "cc_value_animation.hpp"
+
+namespace anim
+{
+    /**
+     * @brief Plays a shared KeyframeClip once, forward, keeping only its time, cached interval and
+     * value, e.g. one per row of a long list all running the same animation.
+     *
+     * Unlike a ValueAnimation it is not an Animation: it has no listeners, loops or driver, its
+     * owner advances it. The values are those of a ValueAnimation created from the same clip.
+     */
+    template <typename T>
+    class ClipPlayer
+    {
+    public:
+        ClipPlayer() = default;
+        explicit ClipPlayer(ClipRef<T> clip) : clip_(std::move(clip)) {}
+
+        const ClipRef<T> &clip() const { return clip_; }
+        void set_clip(ClipRef<T> clip) {
+            clip_ = std::move(clip);
+            interval_ = 0;
+            running_ = running_ && clip_;
+        }
+
+        /**
+         * @brief Rewinds to the start of the clip and runs, a player without a clip does not.
+         */
+        void Start() {
+            running_ = static_cast<bool>(clip_);
+            SetCurrentTime(Duration::zero());
+        }
+        void Stop() { running_ = false; }
+        bool IsRunning() const { return running_; }
+
+        /**
+         * @brief Advances a running player by delta and updates the value, stopping at the end of
+         * the clip.
+         *
+         * @return Whether the player is still running.
+         */
+        bool Advance(Duration delta) {
+            if (!running_ || !clip_) return false;
+            const Duration duration = clip_->duration();
+            time_ += delta;
+            if (time_ >= duration) {
+                time_ = duration;
+                running_ = false;
+            }
+            Update();
+            return running_;
+        }
+        /**
+         * @brief Seeks to a time clamped to the clip and updates the value, running or not. Does
+         * nothing without a clip.
+         */
+        void SetCurrentTime(Duration time) {
+            if (!clip_) return;
+            time_ = std::max(Duration::zero(), std::min(time, clip_->duration()));
+            Update();
+        }
+        Duration current_time() const { return time_; }
+        const T &value() const { return value_; }
+
+    private:
+        // The evaluation of a ValueAnimation playing the clip, for a forward single run
+        void Update() {
+            if (!clip_) return;
+            const KeyframeClip<T> &clip = *clip_;
+            const std::vector<Keyframe<T>> &keyframes = clip.keyframes();
+            if (keyframes.size() < 2) return;
+            const float progress = clip.easing_curve().ValueForProgress(RunProgress(time_, clip.duration(), 1.0f));
+            const size_t interval = clip.index().Find(keyframes, progress, interval_);
+            interval_ = uint32_t(interval);
+            const Keyframe<T> &start = keyframes[interval];
+            value_ = KeyframeValueAt(KeyframeProgress(keyframes), interval, start.value(),
+                                     keyframes[interval + 1].value(), progress, SegmentCurve(start.easing_curve()));
+        }
+
+        ClipRef<T> clip_;
+        Duration time_{0};
+        // See KeyframeIndex::Find()
+        uint32_t interval_ = 0;
+        bool running_ = false;
+        T value_ = T();
+    };
+} // namespace anim
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <type_traits>
 
 namespace anim
 {
@@ -51,19 +54,175 @@ namespace anim
         OutCurve,
         SineCurve,
         CosineCurve,
+        CubicBezier,
+        // The type of curves created from a CurveFunction
+        Custom
+    };
+
+    /**
+     * @brief The number of CurveType values, for tables indexed by type.
+     */
+    constexpr int kCurveTypeCount = int(CurveType::Custom) + 1;
+
+    /**
+     * @brief Instruction sets EasingCurve::ValuesForProgress() can run on.
+     */
+    enum class SimdLevel : int
+    {
+        kScalar,
+        kSse2,
+        kAvx2,
+        kNeon,
+    };
+
+    /**
+     * @brief The part of an EasingCurve which can be stored in a file, see EasingCurve::ToRecord().
+     */
+    struct CurveRecord
+    {
+        int32_t type;
+        // The parameters, or the coefficients of a CubicBezier
+        float params[6];
     };
 
     using CurveFunction = float(*)(float);
+    struct BakedCurveTable;
+    struct BezierSampleTable;
     class EasingCurve
     {
     public:
         EasingCurve() = default;
         EasingCurve(CurveType type);
-        EasingCurve(CurveFunction func) : func_(func) {}
+        EasingCurve(CurveFunction func)
+            : func_(func), type_(uint8_t(CurveType::Custom)), flags_(func ? kValid : uint8_t(0)) {}
+        /**
+         * @brief Creates a CSS style cubic-bezier(x1, y1, x2, y2) timing function, the curve from
+         * (0, 0) to (1, 1) with control points (x1, y1) and (x2, y2). EasingCurve(CurveType::CubicBezier)
+         * is the CSS "ease" curve, cubic-bezier(0.25, 0.1, 0.25, 1.0).
+         *
+         * The progress is solved for the curve parameter by Newton's method, falling back to
+         * bisection, then the curve is evaluated at that parameter. Progress outside [0, 1]
+         * extrapolates along the tangent at the nearest end point.
+         *
+         * @param x1 clamped to [0, 1], so the curve is a function of progress.
+         * @param x2 clamped to [0, 1].
+         * @param sample_table Whether to start Newton's method from a table of samples of the curve,
+         * shared by every curve with the same control points, instead of from the progress. This
+         * saves iterations on strongly curved timings at the cost of building the table once.
+         */
+        static EasingCurve Bezier(float x1, float y1, float x2, float y2, bool sample_table = false);
         float ValueForProgress(float progress) const;
-        bool IsValid() const { return nullptr != func_; }
+        /**
+         * @brief Evaluates the curve for count progress values, progress and values may alias.
+         *
+         * Built-in curves run vectorized kernels of the level returned by simd_level(). For
+         * progress in [0, 1] those stay within kSimdMaxError of ValueForProgress(), the scalar
+         * level and Custom curves give exactly the same values as ValueForProgress().
+         */
+        void ValuesForProgress(const float *progress, float *values, size_t count) const;
+
+        /**
+         * @brief Largest absolute difference between the vectorized kernels and the scalar curves
+         * for progress in [0, 1], 4 * FLT_EPSILON. It is an absolute error bound, not a ULP distance:
+         * values close to 0 may be many ULPs apart while staying within it.
+         */
+        static constexpr float kSimdMaxError = 4 * 1.1920929e-7f;
+
+        /**
+         * @brief The level used by ValuesForProgress(), the best one supported by the CPU by default.
+         */
+        static SimdLevel simd_level();
+        /**
+         * @brief Overrides the detected level, for testing and benchmarking.
+         *
+         * @return false, leaving the level unchanged, if the level is not supported.
+         */
+        static bool SetSimdLevel(SimdLevel level);
+        bool IsValid() const { return 0 != (flags_ & kValid); }
+        CurveType type() const { return CurveType(type_); }
+
+        /**
+         * @brief The amplitude of the Elastic and Bounce curves, 1.0 by default.
+         */
+        float amplitude() const { return params_[0]; }
+        /**
+         * @brief The period of the Elastic curves, 0.3 by default.
+         */
+        float period() const { return params_[1]; }
+        /**
+         * @brief The overshoot of the Back curves, 1.70158 by default which overshoots by 10 percent.
+         */
+        float overshoot() const { return params_[2]; }
+        // Changing a parameter drops the baked table, if any, as it was sampled with the old value
+        void set_amplitude(float amplitude) { SetParameter(0, amplitude); }
+        void set_period(float period) { SetParameter(1, period); }
+        void set_overshoot(float overshoot) { SetParameter(2, overshoot); }
+
+        /**
+         * @brief The control points of a CubicBezier curve, x1, y1, x2, y2.
+         *
+         * @return false, leaving points untouched, if the curve is not a CubicBezier.
+         */
+        bool GetControlPoints(float points[4]) const;
+
+        /**
+         * @brief Describes the curve without pointers. Baked curves are recorded as the curve they
+         * were baked from and bezier curves without their sample table.
+         *
+         * @return false, leaving record untouched, for Custom curves.
+         */
+        bool ToRecord(CurveRecord *record) const;
+        /**
+         * @brief The curve described by a record, Linear if the record is not valid.
+         */
+        static EasingCurve FromRecord(const CurveRecord &record);
+
+        /**
+         * @brief Returns a copy of this curve evaluated by linear interpolation in a table of
+         * resolution + 1 samples, instead of calling the curve function.
+         *
+         * The table is built on first use and shared, read-only, by every curve baked from the same
+         * curve and resolution. Baked curves clamp the progress to [0, 1].
+         *
+         * @param resolution The number of intervals of the table, clamped to [2, 65536].
+         */
+        EasingCurve Baked(int resolution = 256) const;
+        bool IsBaked() const { return 0 != (flags_ & kBaked); }
+        /**
+         * @brief The largest absolute difference to the analytic curve over [0, 1], measured when the
+         * table was built. 0 for curves which are not baked.
+         */
+        float baked_max_error() const;
 
     private:
-        CurveFunction func_ = nullptr;
+        // Bits of flags_
+        static const uint8_t kValid = 1;
+        static const uint8_t kBaked = 2;
+
+        void SetParameter(int index, float value) {
+            // The parameters of a bezier are its coefficients
+            if (CurveType::CubicBezier == type()) return;
+            params_[index] = value;
+            if (IsBaked()) Unbake();
+        }
+        // Back to the curve this one was baked from
+        void Unbake();
+        float BezierValueForProgress(float progress) const;
+
+        // Only what the type needs: the function of a Custom curve, the table of a baked curve or
+        // the sample table of a bezier, if any
+        union {
+            CurveFunction func_ = nullptr;
+            const BakedCurveTable *table_;
+            const BezierSampleTable *bezier_samples_;
+        };
+        // amplitude, period and overshoot, or for CubicBezier the coefficients b, c of x(t) then of
+        // y(t), each being ((a * t + b) * t + c) * t with a = 1 - b - c
+        float params_[4] = {1.0f, 0.3f, 1.70158f, 0.0f};
+        uint8_t type_ = uint8_t(CurveType::Linear);
+        uint8_t flags_ = 0;
     };
+
+    // Every Keyframe embeds a curve, keep it a small value type: 32 bytes on 64-bit targets
+    static_assert(std::is_trivially_copyable<EasingCurve>::value, "EasingCurve must be trivially copyable");
 }
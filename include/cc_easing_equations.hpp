@@ -0,0 +1,131 @@
+/**
+ * @file cc_easing_equations.hpp
+ * @brief The Penner equations of the Linear, Quad and Cubic curves, shared by the runtime curves
+ * of easing.cc and the inlined StaticCurve so both forms of a curve give identical results.
+ */
+/*
+Disclaimer for Robert Penner's Easing Equations license:
+TERMS OF USE - EASING EQUATIONS
+Open source under the BSD License.
+Copyright © 2001 Robert Penner
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+namespace anim
+{
+namespace easing
+{
+using real = float;
+/**
+ * Easing equation function for a simple linear tweening, with no easing.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeNone(real progress)
+{
+    return progress;
+}
+/**
+ * Easing equation function for a quadratic (t^2) easing in: accelerating from zero velocity.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeInQuad(real t)
+{
+    return t*t;
+}
+/**
+* Easing equation function for a quadratic (t^2) easing out: decelerating to zero velocity.
+*
+* @param t		Current time (in frames or seconds).
+* @return		The correct value.
+*/
+inline real easeOutQuad(real t)
+{
+    return -t*(t-2);
+}
+/**
+ * Easing equation function for a quadratic (t^2) easing in/out: acceleration until halfway, then deceleration.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeInOutQuad(real t)
+{
+    t*=2.0;
+    if (t < 1) {
+        return t*t/real(2);
+    } else {
+        --t;
+        return -0.5 * (t*(t-2) - 1);
+    }
+}
+/**
+ * Easing equation function for a quadratic (t^2) easing out/in: deceleration until halfway, then acceleration.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeOutInQuad(real t)
+{
+    if (t < 0.5) return easeOutQuad (t*2)/2;
+    return easeInQuad((2*t)-1)/2 + 0.5;
+}
+/**
+ * Easing equation function for a cubic (t^3) easing in: accelerating from zero velocity.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeInCubic(real t)
+{
+    return t*t*t;
+}
+/**
+ * Easing equation function for a cubic (t^3) easing out: decelerating to zero velocity.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeOutCubic(real t)
+{
+    t-=1.0;
+    return t*t*t + 1;
+}
+/**
+ * Easing equation function for a cubic (t^3) easing in/out: acceleration until halfway, then deceleration.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeInOutCubic(real t)
+{
+    t*=2.0;
+    if(t < 1) {
+        return 0.5*t*t*t;
+    } else {
+        t -= real(2.0);
+        return 0.5*(t*t*t + 2);
+    }
+}
+/**
+ * Easing equation function for a cubic (t^3) easing out/in: deceleration until halfway, then acceleration.
+ *
+ * @param t		Current time (in frames or seconds).
+ * @return		The correct value.
+ */
+inline real easeOutInCubic(real t)
+{
+    if (t < 0.5) return easeOutCubic (2*t)/2;
+    return easeInCubic(2*t - 1)/2 + 0.5;
+}
+} // namespace easing
+} // namespace anim
@@ -15,6 +15,14 @@
  **/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "cc_easing_curve.hpp"
 
 namespace anim
@@ -27,19 +35,231 @@ namespace anim
         Keyframe(float progress, const T &value, 
                 const EasingCurve &curve = EasingCurve(CurveType::Linear))
             : easing_curve_(curve), progress_(progress), value_(value) {}
-        float progress() const { return progress_; }
-        T value() const { return value_; }
+        const float &progress() const { return progress_; }
+        const T &value() const { return value_; }
         void set_progress(float progress) { progress_ = progress; }
         void set_value(const T &value) { value_ = value; }
+        /**
+         * @brief The curve easing the segment from this keyframe to the next one, Linear by default.
+         */
         void set_easing_curve(EasingCurve curve) { easing_curve_ = curve; }
-        EasingCurve easing_curve() const { return easing_curve_; }
+        const EasingCurve &easing_curve() const { return easing_curve_; }
 
         // Support operator '<' for sorting
         bool operator<(const Keyframe &other) const { return progress_ < other.progress_; }
 
     private:
         EasingCurve easing_curve_;
-        float progress_;
-        T value_;
+        float progress_ = 0.0f;
+        T value_ = T();
+    };
+
+    /**
+     * @brief The progress of count keyframes stored stride bytes apart, either in a vector of
+     * Keyframe or in a baked clip.
+     */
+    class KeyframeProgress
+    {
+    public:
+        KeyframeProgress() = default;
+        KeyframeProgress(const float *first, size_t count, size_t stride = sizeof(float))
+            : first_(reinterpret_cast<const char *>(first)), count_(uint32_t(count)), stride_(uint32_t(stride)) {}
+        template <typename T>
+        explicit KeyframeProgress(const std::vector<Keyframe<T>> &keyframes)
+            : first_(keyframes.empty() ? nullptr : reinterpret_cast<const char *>(&keyframes[0].progress())),
+              count_(uint32_t(keyframes.size())), stride_(uint32_t(sizeof(Keyframe<T>))) {}
+
+        float operator[](size_t i) const { return *reinterpret_cast<const float *>(first_ + i * stride_); }
+        size_t size() const { return count_; }
+        float front() const { return (*this)[0]; }
+        float back() const { return (*this)[count_ - 1]; }
+
+    private:
+        const char *first_ = nullptr;
+        // 32 bits, as every ValueAnimation embeds one
+        uint32_t count_ = 0;
+        uint32_t stride_ = sizeof(float);
+    };
+
+    /**
+     * @brief Finds the interval of a sorted keyframe list containing a progress, interval i being
+     * the keyframes i and i + 1.
+     *
+     * Lookups first try the interval of the previous lookup and its neighbours, which covers
+     * playback, then a uniform bucket index over the progress range followed by a short walk,
+     * which covers seeking. Lists of fewer than kMinIndexedCount keyframes are only walked.
+     */
+    class KeyframeIndex
+    {
+    public:
+        static const size_t kMinIndexedCount = 16;
+
+        /**
+         * @brief Rebuilds the index, to be called whenever the keyframes change.
+         */
+        void Build(const KeyframeProgress &keyframes) {
+            owned_.reset();
+            buckets_ = nullptr;
+            bucket_count_ = 0;
+            const size_t count = keyframes.size();
+            if (count < kMinIndexedCount) return;
+            const float start = keyframes.front();
+            const float span = keyframes.back() - start;
+            if (!(span > 0.0f)) return;
+            // One bucket per interval, each holding the interval its lower bound falls in
+            const size_t last = count - 2;
+            const size_t bucket_count = count - 1;
+            owned_.reset(new uint32_t[bucket_count]);
+            start_ = start;
+            scale_ = float(bucket_count) / span;
+            size_t i = 0;
+            for (size_t b = 0; b < bucket_count; ++b) {
+                const float lower = start + float(b) / scale_;
+                while (i < last && keyframes[i + 1] < lower) ++i;
+                owned_[b] = uint32_t(i);
+            }
+            buckets_ = owned_.get();
+            bucket_count_ = uint32_t(bucket_count);
+        }
+        template <typename T>
+        void Build(const std::vector<Keyframe<T>> &keyframes) { Build(KeyframeProgress(keyframes)); }
+
+        /**
+         * @brief Uses buckets exported from another index by buckets(), e.g. stored in a baked clip,
+         * instead of building them. They are not copied and must outlive the index.
+         */
+        void Attach(const uint32_t *buckets, size_t count, float start, float scale) {
+            owned_.reset();
+            buckets_ = count > 0 ? buckets : nullptr;
+            bucket_count_ = buckets_ ? uint32_t(count) : 0;
+            start_ = start;
+            scale_ = scale;
+        }
+
+        /**
+         * @brief Returns the interval i such that keyframes[i].progress() < progress <=
+         * keyframes[i + 1].progress(), the first or last interval for progress out of the range.
+         *
+         * @param keyframes The keyframes the index was built for, at least 2.
+         * @param hint The interval returned by the previous lookup.
+         */
+        size_t Find(const KeyframeProgress &keyframes, float progress, size_t hint) const {
+            const size_t last = keyframes.size() - 2;
+            size_t i = std::min(hint, last);
+            if (Contains(keyframes, i, progress)) return i;
+            if (i < last && Contains(keyframes, i + 1, progress)) return i + 1;
+            if (i > 0 && Contains(keyframes, i - 1, progress)) return i - 1;
+            const size_t count = bucket_count();
+            if (count > 0) {
+                // Clamped as a float before converting, progress from a Custom curve may be huge,
+                // infinite or NaN, which fails the test and starts at the first interval
+                const float x = (progress - start_) * scale_;
+                const size_t bucket = x > 0.0f ? size_t(std::min(x, float(count - 1))) : 0;
+                // Attached buckets come from a file, don't trust them to stay in range
+                i = std::min(size_t(buckets()[bucket]), last);
+            }
+            while (i > 0 && progress <= keyframes[i]) --i;
+            while (i < last && progress > keyframes[i + 1]) ++i;
+            return i;
+        }
+        template <typename T>
+        size_t Find(const std::vector<Keyframe<T>> &keyframes, float progress, size_t hint) const {
+            return Find(KeyframeProgress(keyframes), progress, hint);
+        }
+
+        const uint32_t *buckets() const { return buckets_; }
+        size_t bucket_count() const { return bucket_count_; }
+        float start() const { return start_; }
+        float scale() const { return scale_; }
+
+    private:
+        static bool Contains(const KeyframeProgress &keyframes, size_t i, float progress) {
+            return (0 == i || keyframes[i] < progress)
+                && (i + 2 == keyframes.size() || progress <= keyframes[i + 1]);
+        }
+
+        // Those built by Build(), buckets_ points to them or to attached ones
+        std::unique_ptr<uint32_t[]> owned_;
+        const uint32_t *buckets_ = nullptr;
+        // 32 bits, as a ClipFile holds one per clip
+        uint32_t bucket_count_ = 0;
+        float start_ = 0.0f;
+        float scale_ = 0.0f;
+    };
+
+    /**
+     * @brief What a baked clip is evaluated with besides its keyframes: the index over its buckets
+     * and its segment curves. Built once per clip by the clip's storage, e.g. its ClipFile, and
+     * shared read-only by every animation playing the clip.
+     *
+     * The curves are decoded from their records on the first call to curves(), so building the
+     * index does not page the clip in. Any number of threads may call it at once.
+     */
+    class BakedClipIndex
+    {
+    public:
+        BakedClipIndex() = default;
+        BakedClipIndex(const BakedClipIndex &) = delete;
+        BakedClipIndex &operator=(const BakedClipIndex &) = delete;
+        ~BakedClipIndex() { delete[] curves_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Points the index at the buckets and curve records of a clip of count keyframes,
+         * which are not copied and must outlive it. records is nullptr when the curves are all linear.
+         */
+        void Attach(const uint32_t *buckets, size_t bucket_count, float start, float scale,
+                    const CurveRecord *records, size_t count) {
+            index_.Attach(buckets, bucket_count, start, scale);
+            delete[] curves_.load(std::memory_order_relaxed);
+            curves_.store(nullptr, std::memory_order_relaxed);
+            records_ = count > 1 ? records : nullptr;
+            segment_count_ = records_ ? uint32_t(count - 1) : 0;
+        }
+
+        const KeyframeIndex &index() const { return index_; }
+        /**
+         * @brief The curves of the count - 1 segments, nullptr when they are all linear.
+         */
+        const EasingCurve *curves() const {
+            const EasingCurve *curves = curves_.load(std::memory_order_acquire);
+            return (curves || !records_) ? curves : DecodeCurves();
+        }
+
+    private:
+        const EasingCurve *DecodeCurves() const {
+            EasingCurve *curves = new EasingCurve[segment_count_];
+            for (size_t i = 0; i < segment_count_; ++i) {
+                curves[i] = EasingCurve::FromRecord(records_[i]);
+            }
+            // Another thread may have decoded them meanwhile, its curves are kept
+            EasingCurve *decoded = nullptr;
+            if (!curves_.compare_exchange_strong(decoded, curves, std::memory_order_acq_rel)) {
+                delete[] curves;
+                return decoded;
+            }
+            return curves;
+        }
+
+        KeyframeIndex index_;
+        const CurveRecord *records_ = nullptr;
+        mutable std::atomic<EasingCurve *> curves_{nullptr};
+        uint32_t segment_count_ = 0;
+    };
+
+    /**
+     * @brief Keyframes stored as parallel arrays, typically pointing into a mapped ClipFile, which
+     * a ValueAnimation evaluates in place.
+     */
+    template <typename T>
+    struct BakedClip
+    {
+        // count progress values, sorted
+        const float *progress = nullptr;
+        // count values
+        const T *values = nullptr;
+        size_t count = 0;
+        std::chrono::nanoseconds duration{0};
+        // Owned by the clip's storage, a clip without one is not played
+        const BakedClipIndex *index = nullptr;
     };
 }   // namespace anim
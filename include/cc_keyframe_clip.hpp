@@ -0,0 +1,130 @@
+/**
+ * @file cc_keyframe_clip.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "cc_keyframe.hpp"
+
+namespace anim
+{
+    template <typename T>
+    class KeyframeClip;
+
+    /**
+     * @brief A counted reference to a KeyframeClip, the size of a pointer.
+     */
+    template <typename T>
+    class ClipRef
+    {
+    public:
+        ClipRef() = default;
+        ClipRef(const ClipRef &other) : clip_(other.clip_) {
+            if (clip_) clip_->AddRef();
+        }
+        ClipRef(ClipRef &&other) noexcept : clip_(other.clip_) { other.clip_ = nullptr; }
+        ClipRef &operator=(ClipRef other) noexcept {
+            std::swap(clip_, other.clip_);
+            return *this;
+        }
+        ~ClipRef() {
+            if (clip_) clip_->Release();
+        }
+
+        const KeyframeClip<T> *get() const { return clip_; }
+        const KeyframeClip<T> *operator->() const { return clip_; }
+        const KeyframeClip<T> &operator*() const { return *clip_; }
+        explicit operator bool() const { return nullptr != clip_; }
+
+    private:
+        friend class KeyframeClip<T>;
+        explicit ClipRef(const KeyframeClip<T> *clip) : clip_(clip) { clip_->AddRef(); }
+
+        const KeyframeClip<T> *clip_ = nullptr;
+    };
+
+    /**
+     * @brief An immutable keyframe track, with the curve mapping time to progress over the
+     * keyframes and the duration, shared by any number of animations.
+     *
+     * Clips are only reachable through ClipRef and are destroyed with their last reference, which
+     * may be released from any thread. Nothing in a clip changes after Create(), so animations on
+     * several threads can read it at once.
+     */
+    template <typename T>
+    class KeyframeClip
+    {
+    public:
+        KeyframeClip(const KeyframeClip &) = delete;
+        KeyframeClip &operator=(const KeyframeClip &) = delete;
+
+        /**
+         * @brief Creates a clip from keyframes, sorted like those of a ValueAnimation.
+         *
+         * @param curve Maps the time to the progress over the keyframes, InOutQuad like the
+         * default curve of ValueAnimation.
+         */
+        static ClipRef<T> Create(std::vector<Keyframe<T>> keyframes,
+                                 std::chrono::nanoseconds duration = std::chrono::milliseconds(300),
+                                 const EasingCurve &curve = EasingCurve(CurveType::InOutQuad)) {
+            return ClipRef<T>(new KeyframeClip(std::move(keyframes), duration, curve));
+        }
+        static ClipRef<T> Create(std::initializer_list<Keyframe<T>> keyframes,
+                                 std::chrono::nanoseconds duration = std::chrono::milliseconds(300),
+                                 const EasingCurve &curve = EasingCurve(CurveType::InOutQuad)) {
+            return Create(std::vector<Keyframe<T>>(keyframes), duration, curve);
+        }
+
+        const std::vector<Keyframe<T>> &keyframes() const { return keyframes_; }
+        const KeyframeIndex &index() const { return index_; }
+        std::chrono::nanoseconds duration() const { return duration_; }
+        const EasingCurve &easing_curve() const { return easing_curve_; }
+        /**
+         * @brief The number of ClipRef to this clip, only exact while no other thread copies or
+         * releases one.
+         */
+        uint32_t ref_count() const { return ref_count_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class ClipRef<T>;
+
+        KeyframeClip(std::vector<Keyframe<T>> keyframes, std::chrono::nanoseconds duration, const EasingCurve &curve)
+            : keyframes_(std::move(keyframes)), duration_(duration), easing_curve_(curve) {
+            // stable_sort allocates a buffer even for sorted input, which keyframes nearly always are
+            if (!std::is_sorted(keyframes_.begin(), keyframes_.end())) {
+                std::stable_sort(keyframes_.begin(), keyframes_.end());
+            }
+            index_.Build(keyframes_);
+        }
+
+        void AddRef() const { ref_count_.fetch_add(1, std::memory_order_relaxed); }
+        void Release() const {
+            // The last release sees every write made through the other references
+            if (1 == ref_count_.fetch_sub(1, std::memory_order_acq_rel)) delete this;
+        }
+
+        std::vector<Keyframe<T>> keyframes_;
+        KeyframeIndex index_;
+        std::chrono::nanoseconds duration_;
+        EasingCurve easing_curve_;
+        mutable std::atomic<uint32_t> ref_count_{0};
+    };
+} // namespace anim
@@ -0,0 +1,147 @@
+/**
+ * @file cc_listener_list.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace anim
+{
+    /**
+     * @brief An ordered list of non-owning listener pointers, stored inline up to N listeners so the
+     * common cases never allocate. It holds up to 65535 listeners in the size of N + 1 pointers,
+     * as every animation embeds one.
+     *
+     * The listener pointer is its own handle: whoever adds a listener keeps it alive until it is
+     * removed. Listeners may be added or removed while the list is dispatching, including by the
+     * listener being called. Removed listeners are not called any more, added ones are first
+     * called by the next dispatch.
+     */
+    template <typename Listener, size_t N = 2>
+    class ListenerList
+    {
+    public:
+        ListenerList() = default;
+        ListenerList(const ListenerList &) = delete;
+        ListenerList &operator=(const ListenerList &) = delete;
+        ~ListenerList() {
+            if (capacity_ > N) delete[] heap_;
+        }
+
+        /**
+         * @brief Appends a listener, listeners already in the list are not added twice.
+         */
+        void Add(Listener *listener) {
+            if (nullptr == listener || Find(listener) >= 0) return;
+            if (size_ == capacity_ && !Grow()) return;
+            data()[size_++] = listener;
+        }
+
+        /**
+         * @brief Removes a listener, returns false if it was not in the list.
+         */
+        bool Remove(Listener *listener) {
+            const long i = Find(listener);
+            if (i < 0) return false;
+            if (depth_ > 0) {
+                // Keep the indices stable while dispatching, the hole is removed afterwards
+                data()[i] = nullptr;
+                removed_ = true;
+                return true;
+            }
+            Listener **data = this->data();
+            for (size_t j = size_t(i) + 1; j < size_; ++j) {
+                data[j - 1] = data[j];
+            }
+            --size_;
+            return true;
+        }
+
+        /**
+         * @brief Calls func(listener) on every listener, in the order they were added.
+         */
+        template <typename Func>
+        void Dispatch(Func &&func) {
+            ++depth_;
+            const size_t count = size_;
+            for (size_t i = 0; i < count; ++i) {
+                // The storage may have been reallocated by an Add()
+                Listener *listener = data()[i];
+                if (listener) func(*listener);
+            }
+            if (0 == --depth_ && removed_) Compact();
+        }
+
+        bool empty() const { return 0 == size(); }
+        size_t size() const {
+            if (!removed_) return size_;
+            size_t count = 0;
+            Listener *const *data = this->data();
+            for (size_t i = 0; i < size_; ++i) {
+                if (data[i]) ++count;
+            }
+            return count;
+        }
+
+    private:
+        static const uint32_t kMaxCapacity = 0xffff;
+
+        // The storage, inline until the list outgrows it
+        Listener **data() { return (capacity_ > N) ? heap_ : inline_; }
+        Listener *const *data() const { return (capacity_ > N) ? heap_ : inline_; }
+
+        long Find(Listener *listener) const {
+            Listener *const *data = this->data();
+            for (size_t i = 0; i < size_; ++i) {
+                if (data[i] == listener) return long(i);
+            }
+            return -1;
+        }
+
+        bool Grow() {
+            if (capacity_ == kMaxCapacity) return false;
+            const uint32_t capacity = (capacity_ * 2 < kMaxCapacity) ? capacity_ * 2 : kMaxCapacity;
+            Listener **data = new Listener *[capacity];
+            Listener **old_data = this->data();
+            for (size_t i = 0; i < size_; ++i) {
+                data[i] = old_data[i];
+            }
+            if (capacity_ > N) delete[] heap_;
+            heap_ = data;
+            capacity_ = uint16_t(capacity);
+            return true;
+        }
+
+        void Compact() {
+            Listener **data = this->data();
+            size_t out = 0;
+            for (size_t i = 0; i < size_; ++i) {
+                if (data[i]) data[out++] = data[i];
+            }
+            size_ = uint16_t(out);
+            removed_ = false;
+        }
+
+        static_assert(N > 0 && N < kMaxCapacity, "N must be in [1, 65535)");
+        union {
+            Listener *inline_[N];
+            Listener **heap_;
+        };
+        uint16_t size_ = 0;
+        uint16_t capacity_ = N;
+        uint16_t depth_ = 0;
+        bool removed_ = false;
+    };
+}   // namespace anim
@@ -1 +1,129 @@
+/**
+ * @file cc_property_animation.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
 #pragma once
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "cc_value_animation.hpp"
+
+namespace anim
+{
+    /**
+     * @brief Writes the value through a raw pointer, to a variable or to a data member of an object.
+     */
+    template <typename T>
+    class PointerProperty
+    {
+    public:
+        PointerProperty(T *target) : target_(target) {}
+        template <typename Object>
+        PointerProperty(Object *object, T Object::*member) : target_(&(object->*member)) {}
+
+        void Set(const T &value) const { *target_ = value; }
+        T *target() const { return target_; }
+
+    private:
+        T *target_;
+    };
+
+    /**
+     * @brief Calls a setter fixed at compile time, so the call can be inlined, e.g.
+     * <code>SetterProperty<Sprite, float, &Sprite::set_alpha></code>.
+     *
+     * @tparam Arg The parameter type of the setter, e.g. float or const float &.
+     */
+    template <typename Object, typename Arg, void (Object::*Setter)(Arg)>
+    class SetterProperty
+    {
+    public:
+        SetterProperty(Object *object) : object_(object) {}
+
+        template <typename T>
+        void Set(const T &value) const { (object_->*Setter)(value); }
+        Object *object() const { return object_; }
+
+    private:
+        Object *object_;
+    };
+
+    /**
+     * @brief Writes the value to count properties spaced by a fixed number of bytes in one pass,
+     * e.g. the same member of every element of an array of structs.
+     */
+    template <typename T>
+    class StridedProperty
+    {
+    public:
+        /**
+         * @param stride The distance between two properties in bytes, sizeof(T) for an array of T.
+         */
+        StridedProperty(T *first, size_t count, size_t stride = sizeof(T))
+            : first_(first), count_(count), stride_(stride) {}
+        template <typename Object>
+        StridedProperty(Object *objects, size_t count, T Object::*member)
+            : first_(&(objects->*member)), count_(count), stride_(sizeof(Object)) {}
+
+        void Set(const T &value) const {
+            char *target = reinterpret_cast<char *>(first_);
+            for (size_t i = 0; i < count_; ++i, target += stride_) {
+                *reinterpret_cast<T *>(target) = value;
+            }
+        }
+        size_t count() const { return count_; }
+
+    private:
+        T *first_;
+        size_t count_;
+        size_t stride_;
+    };
+
+    /**
+     * @brief A ValueAnimation storing every value it computes straight into a property, without
+     * going through the type-erased subscriber_.
+     *
+     * subscriber_ and the value listeners are still called when the value changes, after the property
+     * was written. During a parallel tick the write is deferred like the other notifications.
+     *
+     * @tparam Property How the value is written, PointerProperty, SetterProperty, StridedProperty or
+     * any copyable type with a <code>Set(const T &)</code> member.
+     */
+    template <typename T, typename Property = PointerProperty<T>, typename Curve = EasingCurve>
+    class PropertyAnimation final : public ValueAnimation<T, Curve>
+    {
+    public:
+        PropertyAnimation(const Property &property, const T &start_value, const T &end_value)
+            : ValueAnimation<T, Curve>(start_value, end_value), property_(property) {}
+        PropertyAnimation(const Property &property, std::initializer_list<Keyframe<T>> keyframes)
+            : ValueAnimation<T, Curve>(keyframes), property_(property) {}
+        PropertyAnimation(const Property &property, std::vector<Keyframe<T>> keyframes)
+            : ValueAnimation<T, Curve>(std::move(keyframes)), property_(property) {}
+        PropertyAnimation(const Property &property, const BakedClip<T> &clip)
+            : ValueAnimation<T, Curve>(clip), property_(property) {}
+        PropertyAnimation(const Property &property, ClipRef<T> clip)
+            : ValueAnimation<T, Curve>(std::move(clip)), property_(property) {}
+
+        const Property &property() const { return property_; }
+        void set_property(const Property &property) { property_ = property; }
+
+    protected:
+        void UpdateCurrentValue(const T &value) override { property_.Set(value); }
+
+    private:
+        Property property_;
+    };
+} // namespace anim
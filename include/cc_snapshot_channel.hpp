@@ -0,0 +1,153 @@
+/**
+ * @file cc_snapshot_channel.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace anim
+{
+    /**
+     * @brief Hands the animated values of each frame from the animation thread to one reader
+     * thread, e.g. the render thread, through a triple buffer.
+     *
+     * The writer updates slots with Write(), typically from a PropertyAnimation bound with a
+     * SnapshotProperty, then calls Publish() once the driver's tick is over. The reader calls
+     * Acquire() to get the latest published frame. Neither side ever locks or waits: the writer
+     * always has a buffer to fill and the reader keeps the one it holds, so values of any T are
+     * read whole and all from the same frame.
+     *
+     * Publish() only copies the slots written since the buffer it fills was last published, unless
+     * that buffer is more than kHistory frames behind, then it copies every slot.
+     */
+    template <typename T>
+    class SnapshotChannel
+    {
+    public:
+        static const uint64_t kHistory = 4;
+
+        explicit SnapshotChannel(size_t size, const T &initial_value = T())
+            : values_(size, initial_value), written_at_(size, 0) {
+            for (Buffer &buffer : buffers_) {
+                buffer.values.assign(size, initial_value);
+            }
+        }
+        SnapshotChannel(const SnapshotChannel &) = delete;
+        SnapshotChannel &operator=(const SnapshotChannel &) = delete;
+
+        size_t size() const { return values_.size(); }
+
+        // Writer side
+
+        /**
+         * @brief Sets the value of a slot in the frame being prepared.
+         */
+        void Write(size_t slot, const T &value) {
+            values_[slot] = value;
+            if (written_at_[slot] != generation_ + 1) {
+                written_at_[slot] = generation_ + 1;
+                history_[(generation_ + 1) % kHistory].push_back(slot);
+            }
+        }
+        /**
+         * @brief The value of a slot in the frame being prepared.
+         */
+        const T &value(size_t slot) const { return values_[slot]; }
+        /**
+         * @brief Makes the values written so far the latest frame for the reader.
+         */
+        void Publish() {
+            const uint64_t generation = ++generation_;
+            Buffer &buffer = buffers_[back_];
+            if (generation - buffer.generation > kHistory) {
+                buffer.values = values_;
+            } else {
+                for (uint64_t g = buffer.generation + 1; g <= generation; ++g) {
+                    for (size_t slot : history_[g % kHistory]) {
+                        buffer.values[slot] = values_[slot];
+                    }
+                }
+            }
+            buffer.generation = generation;
+            // The list is reused for the frame kHistory frames ahead
+            history_[(generation + 1) % kHistory].clear();
+            back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+        }
+        /**
+         * @brief The number of frames published so far.
+         */
+        uint64_t generation() const { return generation_; }
+
+        // Reader side
+
+        /**
+         * @brief Returns the latest published frame, size() values which stay valid and unchanged
+         * until the next call.
+         *
+         * @param generation Receives the generation of the frame, 0 for the initial values.
+         */
+        const T *Acquire(uint64_t *generation = nullptr) {
+            if (middle_.load(std::memory_order_relaxed) & kFresh) {
+                front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+            }
+            const Buffer &buffer = buffers_[front_];
+            if (generation) *generation = buffer.generation;
+            return buffer.values.data();
+        }
+
+    private:
+        static const uint32_t kIndexMask = 3;
+        // Set on the middle index when it holds a frame the reader has not acquired yet
+        static const uint32_t kFresh = 4;
+
+        struct Buffer
+        {
+            std::vector<T> values;
+            uint64_t generation = 0;
+        };
+
+        Buffer buffers_[3];
+        // Owned by the writer
+        std::vector<T> values_;
+        std::vector<uint64_t> written_at_;
+        // The slots written in each of the last frames
+        std::vector<size_t> history_[kHistory];
+        uint64_t generation_ = 0;
+        uint32_t back_ = 0;
+        // Exchanged between both sides
+        alignas(64) std::atomic<uint32_t> middle_{1};
+        // Owned by the reader
+        alignas(64) uint32_t front_ = 2;
+    };
+
+    /**
+     * @brief A property of PropertyAnimation writing to a slot of a SnapshotChannel.
+     */
+    template <typename T>
+    class SnapshotProperty
+    {
+    public:
+        SnapshotProperty(SnapshotChannel<T> *channel, size_t slot) : channel_(channel), slot_(slot) {}
+
+        void Set(const T &value) const { channel_->Write(slot_, value); }
+        size_t slot() const { return slot_; }
+
+    private:
+        SnapshotChannel<T> *channel_;
+        size_t slot_;
+    };
+} // namespace anim
@@ -0,0 +1,133 @@
+/**
+ * @file cc_static_curve.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+
+#include "cc_easing_curve.hpp"
+#include "cc_easing_equations.hpp"
+
+namespace anim
+{
+    /**
+     * @brief Curves inlined by StaticCurve, calling the same equations as the runtime curves so
+     * both give identical results.
+     */
+    template <CurveType Type>
+    struct StaticEasing
+    {
+        static constexpr bool kInline = false;
+    };
+
+    template <>
+    struct StaticEasing<CurveType::Linear>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeNone(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::InQuad>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeInQuad(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::OutQuad>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeOutQuad(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::InOutQuad>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeInOutQuad(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::OutInQuad>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeOutInQuad(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::InCubic>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeInCubic(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::OutCubic>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeOutCubic(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::InOutCubic>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeInOutCubic(t); }
+    };
+
+    template <>
+    struct StaticEasing<CurveType::OutInCubic>
+    {
+        static constexpr bool kInline = true;
+        static float Ease(float t) { return easing::easeOutInCubic(t); }
+    };
+
+    /**
+     * @brief An easing curve fixed at compile time, usable wherever the curve is a template
+     * parameter, e.g. ValueAnimation<float, StaticCurve<CurveType::OutCubic>>.
+     *
+     * The Linear, Quad and Cubic curves are inlined into the caller, the other types fall back to
+     * an EasingCurve member. It has the same evaluation API as EasingCurve and converts to it.
+     */
+    template <CurveType Type, bool Inline = StaticEasing<Type>::kInline>
+    class StaticCurve
+    {
+    public:
+        float ValueForProgress(float progress) const { return curve_.ValueForProgress(progress); }
+        void ValuesForProgress(const float *progress, float *values, size_t count) const {
+            curve_.ValuesForProgress(progress, values, count);
+        }
+        bool IsValid() const { return true; }
+        CurveType type() const { return Type; }
+        operator EasingCurve() const { return curve_; }
+
+    private:
+        EasingCurve curve_ = EasingCurve(Type);
+    };
+
+    template <CurveType Type>
+    class StaticCurve<Type, true>
+    {
+    public:
+        float ValueForProgress(float progress) const { return StaticEasing<Type>::Ease(progress); }
+        void ValuesForProgress(const float *progress, float *values, size_t count) const {
+            for (size_t i = 0; i < count; ++i) {
+                values[i] = StaticEasing<Type>::Ease(progress[i]);
+            }
+        }
+        bool IsValid() const { return true; }
+        CurveType type() const { return Type; }
+        operator EasingCurve() const { return EasingCurve(Type); }
+    };
+}   // namespace anim
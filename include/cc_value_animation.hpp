@@ -17,12 +17,16 @@
 #include <algorithm>
 #include <cmath>
 #include <initializer_list>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "cc_animation.hpp"
+#include "cc_change_log.hpp"
 #include "cc_keyframe.hpp"
+#include "cc_keyframe_clip.hpp"
+#include "cc_static_curve.hpp"
 
 namespace anim
 {
@@ -53,13 +57,66 @@ namespace anim
     template <typename T> inline T InterpolateValue(const T& start, const T& end, float progress) {
         return _interpolate(start, end, progress);
     }
+
+    /**
+     * @brief The progress over the keyframes at a time within a run, before the animation's curve:
+     * the time over the duration, end_progress when the duration is zero.
+     */
+    inline float RunProgress(Duration time, Duration duration, float end_progress) {
+        // Divided in double, nanosecond counts do not fit a float's mantissa
+        return (duration == Duration::zero()) ? end_progress
+            : float(double(time.count()) / double(duration.count()));
+    }
+
+    /**
+     * @brief The curve easing the segment which starts at a keyframe with that curve, nullptr when
+     * the segment is linear.
+     */
+    inline const EasingCurve *SegmentCurve(const EasingCurve &curve) {
+        return (CurveType::Linear != curve.type() || curve.IsBaked()) ? &curve : nullptr;
+    }
+
+    /**
+     * @brief The value at a progress over the keyframes within an interval, see KeyframeIndex::Find():
+     * the progress between the keyframes starting and ending the interval, of values start and end,
+     * is eased by segment_curve unless it is nullptr, then the values are interpolated.
+     *
+     * What ValueAnimation and ClipPlayer compute each frame, so they play a clip alike.
+     */
+    template <typename T>
+    T KeyframeValueAt(const KeyframeProgress &keyframes, size_t interval, const T &start, const T &end,
+                      float progress, const EasingCurve *segment_curve) {
+        const float start_progress = keyframes[interval];
+        float local_progress = (progress - start_progress) / (keyframes[interval + 1] - start_progress);
+        if (segment_curve) {
+            local_progress = segment_curve->ValueForProgress(local_progress);
+        }
+        return InterpolateValue<T>(start, end, local_progress);
+    }
+
     template <typename T>
     struct ValueUpdateListener
     {
         virtual void OnUpdate(T value) = 0;
     };
 
-    template <typename T>
+    /**
+     * @brief Animates a value of type T through its keyframes.
+     *
+     * The animation's curve maps the time to a progress over the keyframes, then the curve of the
+     * keyframe starting the current segment eases the progress within that segment.
+     *
+     * Millions of animations can be ticked per frame, so what a tick touches is kept together right
+     * after the hot fields of Animation, and the rest is allocated on first use: a
+     * ValueAnimation<float> is at most 216 bytes on 64-bit targets, a tick touches its first 3 cache
+     * lines. Start and end values are held inline, keyframe tracks live in a KeyframeClip, shared
+     * or of its own.
+     *
+     * @tparam T The type of the animated value.
+     * @tparam Curve The easing curve type, EasingCurve picks the curve at runtime while a
+     * StaticCurve fixes it at compile time so it can be inlined.
+     */
+    template <typename T, typename Curve = EasingCurve>
     class ValueAnimation : public Animation
     {
         static_assert(std::is_default_constructible<T>::value, "T must have a default constructor!");
@@ -67,25 +124,71 @@ namespace anim
     public:
 
         using ValueSubscriber = std::function<void(const T&)>;
-        ValueSubscriber subscriber_;
 
         ValueAnimation() = delete;
-        ValueAnimation(const T &start_value, const T &end_value)
-            : ValueAnimation({start_value, end_value}) {}
+        ValueAnimation(const T &start_value, const T &end_value) {
+            BindValues(start_value, end_value);
+        }
 
         ValueAnimation(std::initializer_list<T> values) {
+            std::vector<Keyframe<T>> keyframes;
             size_t num = values.size();
+            if (2 == num) {
+                BindValues(*values.begin(), *(values.begin() + 1));
+                return;
+            }
             // At least 2 values are required
             if (num > 1) {
                 int i = 0;
                 for (auto it = values.begin(); it != values.end(); i++, it++) {
-                    keyframes_.push_back(Keyframe<T>((float)i / (num - 1), *it));
+                    keyframes.push_back(Keyframe<T>((float)i / (num - 1), *it));
                 }
             }
+            clip_ = KeyframeClip<T>::Create(std::move(keyframes));
+            BindKeyframes();
+        }
+
+        ValueAnimation(std::initializer_list<Keyframe<T>> keyframes)
+            : ValueAnimation(std::vector<Keyframe<T>>(keyframes)) {}
+
+        /**
+         * @brief Creates an animation from keyframes built at runtime, e.g. long recorded tracks.
+         * They are moved into a clip of their own, see shared_clip(), unless they are a plain
+         * tween from progress 0 to 1.
+         */
+        explicit ValueAnimation(std::vector<Keyframe<T>> keyframes) {
+            if (2 == keyframes.size() && 0.0f == keyframes[0].progress() && 1.0f == keyframes[1].progress()) {
+                BindValues(keyframes[0].value(), keyframes[1].value(), keyframes[0].easing_curve());
+                return;
+            }
+            clip_ = KeyframeClip<T>::Create(std::move(keyframes));
+            BindKeyframes();
+        }
+
+        /**
+         * @brief Creates an animation playing a shared clip, with the clip's curve and duration.
+         * The animation only holds a reference, its keyframes are not copied.
+         */
+        explicit ValueAnimation(ClipRef<T> clip) : clip_(std::move(clip)) {
+            if (!clip_) return;
+            duration_ = clip_->duration();
+            AssignCurve(&easing_curve_, clip_->easing_curve());
+            BindKeyframes();
         }
 
-        ValueAnimation(std::initializer_list<Keyframe<T>> keyframes) : keyframes_(keyframes) {
-            std::sort(keyframes_.begin(), keyframes_.end());
+        /**
+         * @brief Creates an animation evaluating a baked clip in place, with the clip's duration.
+         * Nothing is copied or allocated, the clip's storage, e.g. its ClipFile, must outlive the
+         * animation.
+         */
+        explicit ValueAnimation(const BakedClip<T> &clip) : duration_(clip.duration), baked_(clip.index) {
+            if (nullptr == baked_) return;
+            key_progress_ = KeyframeProgress(clip.progress, clip.count);
+            key_values_ = reinterpret_cast<const char *>(clip.values);
+            value_stride_ = sizeof(T);
+            // Out of range, so the first frame resolves the segment and constructing does not
+            // page the clip in
+            current_interval_ = uint32_t(clip.count);
         }
 
 #if 0
@@ -110,77 +213,310 @@ namespace anim
         }
 #endif
 
-        void SetDuration(long duration) override { duration_ = duration; }
-        long GetDuration() const override { return duration_; }
-        void set_easing_curve(const EasingCurve &curve) { easing_curve_ = curve; }
-        const std::vector<Keyframe<T>> &keyframes() const { return keyframes_; }
+        /**
+         * @brief Adds a listener called whenever the value changes, like subscriber_ but without
+         * allocating for up to two listeners. It is not owned and must be removed before it is destroyed.
+         */
+        void AddValueListener(ValueUpdateListener<T> *listener) { Cold().value_listeners.Add(listener); }
+        void RemoveValueListener(ValueUpdateListener<T> *listener) {
+            if (cold_) cold_->value_listeners.Remove(listener);
+        }
+        /**
+         * @brief Appends (id, value) to log whenever the value changes, before calling subscriber_.
+         * Passing nullptr stops logging. The log is not owned.
+         */
+        void set_change_log(ChangeLog<T> *log, uint32_t id) {
+            if (!cold_ && nullptr == log) return;
+            Cold().change_log = log;
+            Cold().change_id = id;
+        }
+        ChangeLog<T> *change_log() const { return cold_ ? cold_->change_log : nullptr; }
+        /**
+         * @brief The last value computed, T() before the animation first ran.
+         */
+        const T &current_value() const { return current_value_; }
 
-    protected:
-        void RecalculateCurrentInterval(bool force = false) {
-            // can't interpolate if we don't have at least 2 values
-            if (keyframes_.size() < 2) return;
-            const float end_progress = (direction() == Direction::kForward) ? 1.0f : 0.0f;
-            const float progress = easing_curve_.ValueForProgress(((duration_ == 0) ? end_progress : float(GetCurrentTime()) / float(duration_)));
-            // 0 and 1 are still the boundaries
-            if (force
-                || (current_interval_.start.progress() > 0 && progress < current_interval_.start.progress())
-                || (current_interval_.end.progress() < 1 && progress > current_interval_.end.progress())) {
-                // let's update current_interval_
-                auto it = std::lower_bound(keyframes_.cbegin(), keyframes_.cend(),
-                                           Keyframe<T>(progress, T()));
-                if (it == keyframes_.cbegin()) {
-                    // the item pointed to by it is the start element in the range
-                    if (it->progress() == 0) {
-                        current_interval_.start = *it;
-                        current_interval_.end = *(it + 1);
+        /**
+         * @brief The value the animation shows elapsed after its first frame, the start delay aside,
+         * following its loops, direction and loop mode. Nothing is changed and nobody is notified.
+         *
+         * Only the configuration is read, never the playback state, so any number of threads may
+         * sample one animation at once, even while it is ticked, as long as nothing reconfigures it.
+         */
+        T Evaluate(Duration elapsed) const {
+            if (key_progress_.size() < 2) return T();
+            const LoopTime loop_time = LoopTimeAt(elapsed);
+            const float progress = ProgressAt(loop_time.time, loop_time.loop);
+            // Without a hint the lookup goes straight to the bucket index
+            const size_t interval = FindInterval(progress, key_progress_.size());
+            return ValueAt(progress, interval, SegmentCurveAt(interval));
+        }
+        T Evaluate(long msecs) const { return Evaluate(Duration(std::chrono::milliseconds(msecs))); }
+
+        /**
+         * @brief Evaluates count frames at once, out[i] receiving Evaluate(first + i * interval).
+         * Const and thread-safe like Evaluate().
+         *
+         * The curves ease whole blocks of frames through ValuesForProgress(), so the values match
+         * Evaluate() exactly at SimdLevel::kScalar and within the vectorized curves' error otherwise.
+         */
+        void EvaluateFrames(Duration first, Duration interval, size_t count, T *out) const {
+            if (key_progress_.size() < 2) {
+                std::fill(out, out + count, T());
+                return;
+            }
+            LoopTime loop_times[kFrameBlockSize];
+            float progress[kFrameBlockSize];
+            float local_progress[kFrameBlockSize];
+            size_t intervals[kFrameBlockSize];
+            // Without a hint the first lookup goes straight to the bucket index
+            size_t hint = key_progress_.size();
+            for (size_t begin = 0; begin < count; begin += kFrameBlockSize) {
+                const size_t block = (count - begin < kFrameBlockSize) ? count - begin : kFrameBlockSize;
+                LoopTimesAt(first + interval * long(begin), interval, block, loop_times);
+                for (size_t i = 0; i < block; ++i) {
+                    progress[i] = LinearProgressAt(loop_times[i].time, loop_times[i].loop);
+                }
+                easing_curve_.ValuesForProgress(progress, progress, block);
+                for (size_t i = 0; i < block; ++i) {
+                    hint = intervals[i] = FindInterval(progress[i], hint);
+                    const float start = key_progress_[hint];
+                    local_progress[i] = (progress[i] - start) / (key_progress_[hint + 1] - start);
+                }
+                // Frames run through the segments in order, ease each run with one call
+                for (size_t i = 0; i < block;) {
+                    size_t run_end = i + 1;
+                    while (run_end < block && intervals[run_end] == intervals[i]) ++run_end;
+                    if (const EasingCurve *curve = SegmentCurveAt(intervals[i])) {
+                        curve->ValuesForProgress(local_progress + i, local_progress + i, run_end - i);
                     }
-                } else if (it == keyframes_.cend()) {
-                    --it; // position the iterator on the last item
-                    if (it->progress() == 1) {
-                        // we have an end value (item with progress = 1)
-                        current_interval_.start = *(it - 1);
-                        current_interval_.end = *it;
+                    for (size_t j = i; j < run_end; ++j) {
+                        out[begin + j] = InterpolateValue<T>(key_value(intervals[j]), key_value(intervals[j] + 1),
+                                                             local_progress[j]);
                     }
-                } else {
-                    current_interval_.start = *(it - 1);
-                    current_interval_.end = *it;
+                    i = run_end;
                 }
             }
+        }
+
+        using Animation::SetDuration;
+        void SetDuration(Duration duration) override { duration_ = duration; }
+        Duration duration() const override { return duration_; }
+        void set_easing_curve(const Curve &curve) { easing_curve_ = curve; }
+        const Curve &easing_curve() const { return easing_curve_; }
+        /**
+         * @brief The keyframes, those of shared_clip(), empty for an animation created from a BakedClip.
+         */
+        const std::vector<Keyframe<T>> &keyframes() const {
+            static const std::vector<Keyframe<T>> kNoKeyframes;
+            const ClipRef<T> &clip = shared_clip();
+            return clip ? clip->keyframes() : kNoKeyframes;
+        }
+        /**
+         * @brief The clip played: the one this animation was created from, or one of its own for
+         * keyframes or values passed to the constructor. Empty for a BakedClip.
+         *
+         * Start and end values are played from inline storage, their clip is only built by the
+         * first call, which like any reconfiguration must not race with Evaluate().
+         */
+        const ClipRef<T> &shared_clip() const {
+            if (!clip_ && owns_values()) {
+                const EasingCurve curve = segment_curve_ ? *segment_curve_ : EasingCurve();
+                clip_ = KeyframeClip<T>::Create(
+                    {Keyframe<T>(0.0f, inline_values_[0], curve), Keyframe<T>(1.0f, inline_values_[1])});
+            }
+            return clip_;
+        }
+        size_t keyframe_count() const { return key_progress_.size(); }
+
+    protected:
+        void RecalculateCurrentInterval(bool force = false) {
+            // can't interpolate if we don't have at least 2 values
+            if (key_progress_.size() < 2) return;
+            const float progress = ProgressAt(current_time(), current_loop_);
+            // Without a hint the lookup goes straight to the bucket index
+            const size_t interval = FindInterval(progress, force ? key_progress_.size() : current_interval_);
+            if (interval != current_interval_ || force) {
+                current_interval_ = uint32_t(interval);
+                ResolveSegmentCurve();
+            }
             SetCurrentValueForProgress(progress);
         }
 
-        void SetCurrentValueForProgress(const float progress) {
-            const float start_progress = current_interval_.start.progress();
-            const float end_progress = current_interval_.end.progress();
-            const float local_progress = (progress - start_progress) / (end_progress - start_progress);
-            T ret = InterpolateValue<T>(current_interval_.start.value(), current_interval_.end.value(), local_progress);
-            std::swap(current_value_, ret);
+        // The progress over the keyframes at a time within a loop
+        float ProgressAt(Duration time, int loop) const {
+            return easing_curve_.ValueForProgress(LinearProgressAt(time, loop));
+        }
+        // The same before the animation's curve
+        float LinearProgressAt(Duration time, int loop) const {
+            if (LoopMode::kReverse == loop_mode() && (loop & 1)) {
+                time = duration_ - time;
+            }
+            return RunProgress(time, duration_, (direction() == Direction::kForward) ? 1.0f : 0.0f);
+        }
+
+        T ValueAt(float progress, size_t interval, const EasingCurve *segment_curve) const {
+            return KeyframeValueAt(key_progress_, interval, key_value(interval), key_value(interval + 1), progress,
+                                   segment_curve);
+        }
 
+        void SetCurrentValueForProgress(const float progress) {
+            T value = ValueAt(progress, current_interval_, segment_curve_);
+            // The first value after a start is reported even if it equals the previous one
+            const bool changed = !has_value_ || current_value_ != value;
+            if (changed) {
+                current_value_ = std::move(value);
+                has_value_ = true;
+            }
+            // During a parallel tick the driver delivers these on its thread, with the last value
+            if (DeferNotification(changed ? kPendingValueUpdate | kPendingValueChange : kPendingValueUpdate)) return;
             UpdateCurrentValue(current_value_);
-            // TODO: notify the value has changed
-            if (current_value_ != ret) {
-                if (subscriber_) {
-                    subscriber_(current_value_);
-                }
+            if (changed) NotifyValueChanged();
+        }
+
+        void NotifyValueChanged() {
+            if (cold_ && cold_->change_log) {
+                cold_->change_log->Append(cold_->change_id, current_value_);
+            }
+            if (subscriber_) {
+                subscriber_(current_value_);
             }
+            if (!cold_) return;
+            const T &value = current_value_;
+            cold_->value_listeners.Dispatch([&value](ValueUpdateListener<T> &listener) { listener.OnUpdate(value); });
+        }
+
+        void DeliverPendingNotifications() override {
+            const uint16_t pending = pending_notifications_;
+            if (pending & kPendingValueUpdate) UpdateCurrentValue(current_value_);
+            if (pending & kPendingValueChange) NotifyValueChanged();
+            Animation::DeliverPendingNotifications();
         }
 
         virtual void UpdateCurrentValue(const T& value) {
         }
 
-        void UpdateCurrentTime(long current_time) override {
+        void UpdateState(State new_state, State old_state) override {
+            if (State::kStopped == old_state) has_value_ = false;
+            Animation::UpdateState(new_state, old_state);
+        }
+
+        void UpdateCurrentTime(Duration current_time) override {
             RecalculateCurrentInterval();
         }
 
     private:
-        std::vector<Keyframe<T>> keyframes_;
-        struct {
-            Keyframe<T> start, end;
-        } current_interval_;
-        EasingCurve easing_curve_ = EasingCurve(CurveType::InOutQuad);
-        T current_value_;
-        long duration_ = 300L;
-        bool playing_backwards_ = false;
-        int current_iteration_ = 0;
+        // Frames evaluated together by EvaluateFrames(), on the stack
+        static const size_t kFrameBlockSize = 128;
+
+        // InOutQuad unless the curve type says otherwise
+        template <typename C = Curve>
+        static typename std::enable_if<std::is_same<C, EasingCurve>::value, C>::type DefaultCurve() {
+            return EasingCurve(CurveType::InOutQuad);
+        }
+        template <typename C = Curve>
+        static typename std::enable_if<!std::is_same<C, EasingCurve>::value, C>::type DefaultCurve() {
+            return C();
+        }
+
+        // Takes the clip's curve when the animation's curve is chosen at runtime
+        template <typename C>
+        static void AssignCurve(C *curve, const EasingCurve &clip_curve) {}
+        static void AssignCurve(EasingCurve *curve, const EasingCurve &clip_curve) { *curve = clip_curve; }
+
+        // Points the views at the keyframes of clip_, the same layout as a baked clip with wider strides
+        void BindKeyframes() {
+            const std::vector<Keyframe<T>> &keyframes = clip_->keyframes();
+            key_progress_ = KeyframeProgress(keyframes);
+            key_values_ = keyframes.empty() ? nullptr : reinterpret_cast<const char *>(&keyframes[0].value());
+            value_stride_ = sizeof(Keyframe<T>);
+            ResolveSegmentCurve();
+        }
+
+        // Start and end values, with the curve of the only segment held in the cold data unless it is linear
+        void BindValues(const T &start_value, const T &end_value, const EasingCurve &curve = EasingCurve()) {
+            static const float kProgress[2] = {0.0f, 1.0f};
+            inline_values_[0] = start_value;
+            inline_values_[1] = end_value;
+            key_progress_ = KeyframeProgress(kProgress, 2);
+            key_values_ = reinterpret_cast<const char *>(inline_values_);
+            value_stride_ = sizeof(T);
+            if (SegmentCurve(curve)) {
+                Cold().segment_curve = curve;
+                segment_curve_ = &cold_->segment_curve;
+            }
+        }
+        bool owns_values() const { return reinterpret_cast<const char *>(inline_values_) == key_values_; }
+
+        // Only called with at least 2 keyframes. Beyond 2 either the clip or the baked clip's index exists
+        size_t FindInterval(float progress, size_t hint) const {
+            if (2 == key_progress_.size()) return 0;
+            const KeyframeIndex &index = baked_ ? baked_->index() : clip_->index();
+            return index.Find(key_progress_, progress, hint);
+        }
+
+        const T &key_value(size_t i) const {
+            return *reinterpret_cast<const T *>(key_values_ + i * value_stride_);
+        }
+
+        // The curve of the keyframe starting an interval, nullptr when it is linear
+        const EasingCurve *SegmentCurveAt(size_t interval) const {
+            if (interval + 1 >= key_progress_.size()) return nullptr;
+            if (baked_) {
+                const EasingCurve *curves = baked_->curves();
+                return curves ? SegmentCurve(curves[interval]) : nullptr;
+            }
+            // Set once by BindValues()
+            if (owns_values()) return segment_curve_;
+            return SegmentCurve(clip_->keyframes()[interval].easing_curve());
+        }
+
+        // Only called when the interval changes, which playback rarely does
+        void ResolveSegmentCurve() {
+            segment_curve_ = SegmentCurveAt(current_interval_);
+        }
+
+        // What a tick reads and writes, right after the hot fields of Animation: up to cold_, within
+        // the first 3 cache lines for a ValueAnimation<float>. The keyframes evaluated,
+        // inline_values_, those of clip_ or those of a baked clip
+        KeyframeProgress key_progress_;
+        const char *key_values_ = nullptr;
+        uint32_t value_stride_ = sizeof(T);
+        // Index of the keyframe starting the interval, see KeyframeIndex::Find()
+        uint32_t current_interval_ = 0;
+        // Points into the keyframes or the baked clip's curves, which are not modified after
+        // construction, or to the cold segment_curve
+        const EasingCurve *segment_curve_ = nullptr;
+        Duration duration_ = std::chrono::milliseconds(300);
+        T current_value_ = T();
+        // The start and end values, when the animation has no other keyframes
+        T inline_values_[2];
+        // Whether current_value_ was computed since the animation started
+        bool has_value_ = false;
+        Curve easing_curve_ = DefaultCurve();
+        // The index and curves of a baked clip, owned by its storage
+        const BakedClipIndex *baked_ = nullptr;
+        // Built on demand for start and end values, see shared_clip()
+        mutable ClipRef<T> clip_;
+
+        // What few animations use, allocated on first use
+        struct ColdData
+        {
+            ListenerList<ValueUpdateListener<T>> value_listeners;
+            ChangeLog<T> *change_log = nullptr;
+            uint32_t change_id = 0;
+            // The curve of the only segment of start and end values
+            EasingCurve segment_curve;
+        };
+        std::unique_ptr<ColdData> cold_;
+
+        ColdData &Cold() {
+            if (!cold_) cold_.reset(new ColdData());
+            return *cold_;
+        }
+
+    public:
+        // Last, only read when the value changes
+        ValueSubscriber subscriber_;
     };
 }
@@ -0,0 +1,307 @@
+/**
+ * @file cc_value_types.h
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#pragma once
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_ANIMATION_VALUE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CC_ANIMATION_VALUE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "cc_value_animation.hpp"
+
+namespace anim
+{
+    /**
+     * @brief Linear interpolation of 2, 3 or 4 packed floats, <code>a + (b - a) * t</code> per
+     * component like InterpolateValue<float>, with the baseline vector instructions of the target
+     * (SSE2 or NEON). Only the components are read and written, never the bytes after them.
+     */
+    namespace value_simd
+    {
+#if CC_ANIMATION_VALUE_SSE2
+        inline __m128 Load2(const float *p) { return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(p)); }
+        inline void Store2(float *p, __m128 v) { _mm_storel_pi(reinterpret_cast<__m64 *>(p), v); }
+        inline __m128 Load3(const float *p) { return _mm_movelh_ps(Load2(p), _mm_load_ss(p + 2)); }
+        inline void Store3(float *p, __m128 v) {
+            Store2(p, v);
+            _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+        }
+        inline __m128 Lerp(__m128 a, __m128 b, float t) {
+            return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(t)));
+        }
+
+        inline void Lerp2(const float *a, const float *b, float t, float *out) { Store2(out, Lerp(Load2(a), Load2(b), t)); }
+        inline void Lerp3(const float *a, const float *b, float t, float *out) { Store3(out, Lerp(Load3(a), Load3(b), t)); }
+        inline void Lerp4(const float *a, const float *b, float t, float *out) {
+            _mm_storeu_ps(out, Lerp(_mm_loadu_ps(a), _mm_loadu_ps(b), t));
+        }
+        // wa * a + wb * b
+        inline void Blend4(const float *a, float wa, const float *b, float wb, float *out) {
+            _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(wa)),
+                                          _mm_mul_ps(_mm_loadu_ps(b), _mm_set1_ps(wb))));
+        }
+#elif CC_ANIMATION_VALUE_NEON
+        inline void Lerp2(const float *a, const float *b, float t, float *out) {
+            const float32x2_t va = vld1_f32(a);
+            vst1_f32(out, vadd_f32(va, vmul_n_f32(vsub_f32(vld1_f32(b), va), t)));
+        }
+        inline void Lerp3(const float *a, const float *b, float t, float *out) {
+            Lerp2(a, b, t, out);
+            out[2] = a[2] + (b[2] - a[2]) * t;
+        }
+        inline void Lerp4(const float *a, const float *b, float t, float *out) {
+            const float32x4_t va = vld1q_f32(a);
+            vst1q_f32(out, vaddq_f32(va, vmulq_n_f32(vsubq_f32(vld1q_f32(b), va), t)));
+        }
+        inline void Blend4(const float *a, float wa, const float *b, float wb, float *out) {
+            vst1q_f32(out, vaddq_f32(vmulq_n_f32(vld1q_f32(a), wa), vmulq_n_f32(vld1q_f32(b), wb)));
+        }
+#else
+        template <int N>
+        inline void LerpN(const float *a, const float *b, float t, float *out) {
+            for (int i = 0; i < N; ++i) out[i] = a[i] + (b[i] - a[i]) * t;
+        }
+        inline void Lerp2(const float *a, const float *b, float t, float *out) { LerpN<2>(a, b, t, out); }
+        inline void Lerp3(const float *a, const float *b, float t, float *out) { LerpN<3>(a, b, t, out); }
+        inline void Lerp4(const float *a, const float *b, float t, float *out) { LerpN<4>(a, b, t, out); }
+        inline void Blend4(const float *a, float wa, const float *b, float wb, float *out) {
+            for (int i = 0; i < 4; ++i) out[i] = a[i] * wa + b[i] * wb;
+        }
+#endif
+    } // namespace value_simd
+
+    struct Vec2
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+
+        Vec2() = default;
+        constexpr Vec2(float x, float y) : x(x), y(y) {}
+
+        Vec2 operator+(const Vec2 &other) const { return Vec2(x + other.x, y + other.y); }
+        Vec2 operator-(const Vec2 &other) const { return Vec2(x - other.x, y - other.y); }
+        Vec2 operator*(float scale) const { return Vec2(x * scale, y * scale); }
+        bool operator==(const Vec2 &other) const { return x == other.x && y == other.y; }
+        bool operator!=(const Vec2 &other) const { return !(*this == other); }
+    };
+
+    struct Vec3
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+
+        Vec3() = default;
+        constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+        Vec3 operator+(const Vec3 &other) const { return Vec3(x + other.x, y + other.y, z + other.z); }
+        Vec3 operator-(const Vec3 &other) const { return Vec3(x - other.x, y - other.y, z - other.z); }
+        Vec3 operator*(float scale) const { return Vec3(x * scale, y * scale, z * scale); }
+        bool operator==(const Vec3 &other) const { return x == other.x && y == other.y && z == other.z; }
+        bool operator!=(const Vec3 &other) const { return !(*this == other); }
+    };
+
+    struct Vec4
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 0.0f;
+
+        Vec4() = default;
+        constexpr Vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+        Vec4 operator+(const Vec4 &other) const { return Vec4(x + other.x, y + other.y, z + other.z, w + other.w); }
+        Vec4 operator-(const Vec4 &other) const { return Vec4(x - other.x, y - other.y, z - other.z, w - other.w); }
+        Vec4 operator*(float scale) const { return Vec4(x * scale, y * scale, z * scale, w * scale); }
+        bool operator==(const Vec4 &other) const {
+            return x == other.x && y == other.y && z == other.z && w == other.w;
+        }
+        bool operator!=(const Vec4 &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief An RGBA color in linear space with premultiplied alpha, so interpolating it component
+     * by component neither darkens the midpoints of a gradient nor bleeds the color of a
+     * transparent end. Transparent black by default.
+     */
+    struct Color
+    {
+        float r = 0.0f;
+        float g = 0.0f;
+        float b = 0.0f;
+        float a = 0.0f;
+
+        Color() = default;
+        /**
+         * @brief A color from premultiplied linear components, see FromLinear() and FromSrgb().
+         */
+        constexpr Color(float r, float g, float b, float a) : r(r), g(g), b(b), a(a) {}
+
+        /**
+         * @brief A color from linear components with straight alpha.
+         */
+        static Color FromLinear(float r, float g, float b, float a) { return Color(r * a, g * a, b * a, a); }
+        /**
+         * @brief A color from sRGB encoded components in [0, 1] with straight alpha, e.g. a CSS
+         * color divided by 255.
+         */
+        static Color FromSrgb(float r, float g, float b, float a) {
+            return FromLinear(SrgbToLinear(r), SrgbToLinear(g), SrgbToLinear(b), a);
+        }
+        /**
+         * @brief The sRGB encoded components with straight alpha, 0 for a transparent color.
+         */
+        void ToSrgb(float rgba[4]) const {
+            const float inv_alpha = (a > 0.0f) ? 1.0f / a : 0.0f;
+            rgba[0] = LinearToSrgb(r * inv_alpha);
+            rgba[1] = LinearToSrgb(g * inv_alpha);
+            rgba[2] = LinearToSrgb(b * inv_alpha);
+            rgba[3] = a;
+        }
+
+        static float SrgbToLinear(float c) {
+            return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        static float LinearToSrgb(float c) {
+            return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        }
+
+        Color operator+(const Color &other) const { return Color(r + other.r, g + other.g, b + other.b, a + other.a); }
+        Color operator-(const Color &other) const { return Color(r - other.r, g - other.g, b - other.b, a - other.a); }
+        Color operator*(float scale) const { return Color(r * scale, g * scale, b * scale, a * scale); }
+        bool operator==(const Color &other) const {
+            return r == other.r && g == other.g && b == other.b && a == other.a;
+        }
+        bool operator!=(const Color &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief A rotation as a unit quaternion x i + y j + z k + w, the identity by default.
+     * Interpolated by Slerp().
+     */
+    struct Quat
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 1.0f;
+
+        Quat() = default;
+        constexpr Quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+        /**
+         * @brief The rotation by angle radians around an axis, which needs not be normalized.
+         */
+        static Quat FromAxisAngle(const Vec3 &axis, float angle) {
+            const float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+            if (length <= 0.0f) return Quat();
+            const float s = std::sin(angle * 0.5f) / length;
+            return Quat(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+        }
+
+        float Dot(const Quat &other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
+        /**
+         * @brief This quaternion scaled to unit length, the identity if it is 0.
+         */
+        Quat Normalized() const {
+            const float length_squared = Dot(*this);
+            if (length_squared <= 0.0f) return Quat();
+            const float scale = 1.0f / std::sqrt(length_squared);
+            return Quat(x * scale, y * scale, z * scale, w * scale);
+        }
+        /**
+         * @brief The rotation by other followed by this one.
+         */
+        Quat operator*(const Quat &other) const {
+            return Quat(w * other.x + x * other.w + y * other.z - z * other.y,
+                        w * other.y - x * other.z + y * other.w + z * other.x,
+                        w * other.z + x * other.y - y * other.x + z * other.w,
+                        w * other.w - x * other.x - y * other.y - z * other.z);
+        }
+        Vec3 Rotate(const Vec3 &v) const {
+            // v + 2 q x (q x v + w v), with q the vector part
+            const Vec3 q(x, y, z);
+            const Vec3 t(2.0f * (y * v.z - z * v.y), 2.0f * (z * v.x - x * v.z), 2.0f * (x * v.y - y * v.x));
+            return v + t * w + Vec3(q.y * t.z - q.z * t.y, q.z * t.x - q.x * t.z, q.x * t.y - q.y * t.x);
+        }
+        bool operator==(const Quat &other) const {
+            return x == other.x && y == other.y && z == other.z && w == other.w;
+        }
+        bool operator!=(const Quat &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Interpolates linearly between two rotations the shorter way round then normalizes,
+     * cheaper than Slerp() but not at a constant angular speed. At progress 0 it may give -start,
+     * the same rotation.
+     */
+    inline Quat Nlerp(const Quat &start, const Quat &end, float progress) {
+        // q and -q are the same rotation, start from the one closer to end
+        const float sign = (start.Dot(end) < 0.0f) ? -1.0f : 1.0f;
+        const Quat from(start.x * sign, start.y * sign, start.z * sign, start.w * sign);
+        Quat result;
+        value_simd::Lerp4(&from.x, &end.x, progress, &result.x);
+        return result.Normalized();
+    }
+
+    /**
+     * @brief Interpolates between two rotations the shorter way round at a constant angular speed,
+     * falling back to Nlerp() when they are too close for the division by sin(angle). At progress 0
+     * it may give -start, the same rotation, so that progress 1 gives exactly end.
+     */
+    inline Quat Slerp(const Quat &start, const Quat &end, float progress) {
+        const float dot = start.Dot(end);
+        const float sign = (dot < 0.0f) ? -1.0f : 1.0f;
+        const float cos_angle = dot * sign;
+        // Below about 1.8 degrees
+        if (cos_angle > 0.9995f) return Nlerp(start, end, progress);
+        const float angle = std::acos(cos_angle);
+        const float sin_angle = std::sin(angle);
+        Quat result;
+        value_simd::Blend4(&start.x, sign * std::sin((1.0f - progress) * angle) / sin_angle,
+                           &end.x, std::sin(progress * angle) / sin_angle, &result.x);
+        return result;
+    }
+
+    template <> inline Vec2 InterpolateValue<Vec2>(const Vec2 &start, const Vec2 &end, float progress) {
+        Vec2 result;
+        value_simd::Lerp2(&start.x, &end.x, progress, &result.x);
+        return result;
+    }
+    template <> inline Vec3 InterpolateValue<Vec3>(const Vec3 &start, const Vec3 &end, float progress) {
+        Vec3 result;
+        value_simd::Lerp3(&start.x, &end.x, progress, &result.x);
+        return result;
+    }
+    template <> inline Vec4 InterpolateValue<Vec4>(const Vec4 &start, const Vec4 &end, float progress) {
+        Vec4 result;
+        value_simd::Lerp4(&start.x, &end.x, progress, &result.x);
+        return result;
+    }
+    template <> inline Color InterpolateValue<Color>(const Color &start, const Color &end, float progress) {
+        Color result;
+        value_simd::Lerp4(&start.r, &end.r, progress, &result.r);
+        return result;
+    }
+    template <> inline Quat InterpolateValue<Quat>(const Quat &start, const Quat &end, float progress) {
+        return Slerp(start, end, progress);
+    }
+} // namespace anim
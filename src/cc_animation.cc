@@ -15,13 +15,88 @@
  **/
 #include <algorithm>
 #include "cc_animation.hpp"
+#include "cc_animation_driver.hpp"
+#include "cc_animation_set.hpp"
 
 namespace anim
 {
-    long Animation::GetTotalDuration() const {
-        auto duration = GetDuration();
-        if (duration <= 0) return duration;
-        if (loop_count_ < 0) return -1; 
+    struct Animation::ColdData
+    {
+        std::function<void(State)> state_listener;
+        Duration start_delay{0};
+        AnimationSet *group = nullptr;
+        ListenerList<AnimationListener> listeners;
+    };
+
+    Animation::Animation()
+        : pending_notifications_(0), delay_pending_(0), direction_(Direction::kForward), loop_mode_(LoopMode::kRestart) {}
+
+    Animation::~Animation() {
+        if (AnimationSet *group = this->group()) {
+            group->RemoveAnimation(this);
+        }
+        if (driver_slot_ >= 0) {
+            driver()->UnregisterAnimation(this);
+        }
+    }
+
+    void Animation::set_driver(AnimationDriver *driver) {
+        if (driver_ == driver) return;
+        const bool registered = driver_slot_ >= 0;
+        if (registered) this->driver()->UnregisterAnimation(this);
+        driver_ = driver;
+        if (registered) this->driver()->RegisterAnimation(this);
+    }
+
+    AnimationDriver *Animation::driver() const {
+        return driver_ ? driver_ : &AnimationDriver::GetInstance();
+    }
+
+    Animation::ColdData &Animation::Cold() {
+        if (!cold_) cold_.reset(new ColdData());
+        return *cold_;
+    }
+
+    void Animation::set_start_delay(Duration delay) {
+        delay = std::max(delay, Duration::zero());
+        if (cold_ || delay != Duration::zero()) Cold().start_delay = delay;
+    }
+
+    Duration Animation::start_delay() const {
+        return cold_ ? cold_->start_delay : Duration::zero();
+    }
+
+    AnimationSet *Animation::group() const {
+        return cold_ ? cold_->group : nullptr;
+    }
+
+    void Animation::set_group(AnimationSet *group) {
+        if (cold_ || group) Cold().group = group;
+    }
+
+    void Animation::AddAnimationListener(AnimationListener *listener) {
+        if (listener) Cold().listeners.Add(listener);
+    }
+
+    void Animation::RemoveAnimationListener(AnimationListener *listener) {
+        if (cold_) cold_->listeners.Remove(listener);
+    }
+
+    void Animation::SetStateListener(std::function<void(State)> listener) {
+        if (cold_ || listener) Cold().state_listener = std::move(listener);
+    }
+
+    std::function<void(Animation::State)> Animation::GetStateListener() const {
+        return cold_ ? cold_->state_listener : nullptr;
+    }
+
+    Duration Animation::total_duration() const {
+        return TotalDuration(duration());
+    }
+
+    Duration Animation::TotalDuration(Duration duration) const {
+        if (duration <= Duration::zero()) return duration;
+        if (loop_count_ < 0) return Duration(-1);
         return duration * loop_count_;
     }
 
@@ -30,14 +105,94 @@ namespace anim
         SetState(State::kRunning);
     }
 
+    // See Animation::SetDeferredAnimations()
+    static thread_local std::vector<Animation *> *t_deferred_animations = nullptr;
+
+    void Animation::SetDeferredAnimations(std::vector<Animation *> *animations) {
+        t_deferred_animations = animations;
+    }
+
+    bool Animation::DeferNotification(uint16_t notification) {
+        std::vector<Animation *> *deferred = t_deferred_animations;
+        if (nullptr == deferred) return false;
+        if (0 == pending_notifications_) deferred->push_back(this);
+        pending_notifications_ |= notification;
+        return true;
+    }
+
+    void Animation::DeliverPendingNotifications() {
+        const uint16_t pending = pending_notifications_;
+        pending_notifications_ = 0;
+        // The state may have changed since, by a notification delivered earlier
+        if ((pending & kPendingUnregister) && State::kRunning != state_) {
+            driver()->UnregisterAnimation(this);
+        }
+        if ((pending & kPendingState) && cold_ && cold_->state_listener) cold_->state_listener(state_);
+        if (pending & kPendingStart) NotifyListeners(&AnimationListener::OnAnimationStart);
+        if (pending & kPendingRepeat) NotifyListeners(&AnimationListener::OnAnimationRepeat);
+        if (pending & kPendingPause) NotifyListeners(&AnimationListener::OnAnimationPause);
+        if (pending & kPendingResume) NotifyListeners(&AnimationListener::OnAnimationResume);
+        if (pending & kPendingCancel) NotifyListeners(&AnimationListener::OnAnimationCancel);
+        if (pending & kPendingEnd) NotifyListeners(&AnimationListener::OnAnimationEnd);
+    }
+
     void Animation::Stop() {
+        const State old_state = state_;
         state_ = State::kStopped;
-        last_update_time_ = -1;
+        last_update_time_ = Duration(-1);
+        // The driver's list is only touched from its own thread
+        if (!DeferNotification(kPendingUnregister)) driver()->UnregisterAnimation(this);
+        if (State::kStopped != old_state) {
+            NotifyListeners(&AnimationListener::OnAnimationEnd);
+        }
+    }
+
+    void Animation::Cancel() {
+        const State old_state = state_;
+        state_ = State::kStopped;
+        if (!DeferNotification(kPendingUnregister)) driver()->UnregisterAnimation(this);
+        if (State::kStopped != old_state) {
+            NotifyListeners(&AnimationListener::OnAnimationCancel);
+            NotifyListeners(&AnimationListener::OnAnimationEnd);
+        }
     }
 
-    void Animation::Cancel() { state_ = State::kStopped; }
-    void Animation::Pause() { state_ = State::kPaused; }
-    void Animation::Resume() { state_ = State::kRunning; }
+    void Animation::Pause() {
+        const State old_state = state_;
+        state_ = State::kPaused;
+        if (!DeferNotification(kPendingUnregister)) driver()->UnregisterAnimation(this);
+        if (State::kRunning == old_state) {
+            NotifyListeners(&AnimationListener::OnAnimationPause);
+        }
+    }
+
+    void Animation::Resume() {
+        if (state_ != State::kPaused) return;
+        state_ = State::kRunning;
+        // Restart the frame delta from the next tick, so the paused interval is skipped
+        last_update_time_ = Duration(-1);
+        if (!group()) driver()->RegisterAnimation(this);
+        NotifyListeners(&AnimationListener::OnAnimationResume);
+    }
+
+    void Animation::NotifyListeners(void (AnimationListener::*callback)(Animation &)) {
+        if (t_deferred_animations) {
+            const uint16_t notification =
+                (&AnimationListener::OnAnimationStart == callback) ? kPendingStart
+                : (&AnimationListener::OnAnimationRepeat == callback) ? kPendingRepeat
+                : (&AnimationListener::OnAnimationPause == callback) ? kPendingPause
+                : (&AnimationListener::OnAnimationResume == callback) ? kPendingResume
+                : (&AnimationListener::OnAnimationCancel == callback) ? kPendingCancel
+                : kPendingEnd;
+            DeferNotification(notification);
+            return;
+        }
+        if (cold_) {
+            cold_->listeners.Dispatch([this, callback](AnimationListener &listener) { (listener.*callback)(*this); });
+        }
+        // After the listeners, which may restart the animation, see TickObserver::OnAnimationEnd()
+        if (&AnimationListener::OnAnimationEnd == callback) driver()->NotifyAnimationEnd(this);
+    }
 
     void Animation::SetState(State new_state) {
         if (state_ == new_state) return;
@@ -54,92 +209,118 @@ namespace anim
             //we don't call setCurrentTime because this might change the way the animation
             //behaves: changing the state or changing the current value
             total_current_time_ = current_time_ =
-                (direction_ == Direction::kForward) ?  0 : (loop_count_ == -1 ? GetDuration() : GetTotalDuration());
+                (direction_ == Direction::kForward) ? Duration::zero() : (loop_count_ == -1 ? duration() : total_duration());
+            // Rewind the loop too, so restarting doesn't look like a repeat
+            current_loop_ = (direction_ == Direction::kForward || loop_count_ < 0) ? 0 : loop_count_ - 1;
+            delay_pending_ = 1;
             }
 
             state_ = new_state;
-            // TODO: Register timer.
+            // Children of a group are driven by the group
+            if (State::kRunning == state_ && !group()) {
+                driver()->RegisterAnimation(this);
+            } else if (!DeferNotification(kPendingUnregister)) {
+                driver()->UnregisterAnimation(this);
+            }
 
             UpdateState(new_state, old_state);
             // this is to be safe if updateState changes the state
             if (new_state != state_) return;
             if (State::kRunning == state_ && State::kStopped == old_state) {
-                // TODO: Check if is group
-                SetCurrentTime(total_current_time_);
+                NotifyListeners(&AnimationListener::OnAnimationStart);
+                // this is to be safe if a listener changes the state
+                if (State::kRunning != state_) return;
+                // The group sets the time of its children
+                if (!group()) SetCurrentTime(total_current_time_);
             }
     }
 
     void Animation::UpdateState(State new_state, State old_state)
     {
         state_ = new_state;
-        if (state_listener_) {
-            state_listener_(state_);
+        if (cold_ && cold_->state_listener && !DeferNotification(kPendingState)) {
+            cold_->state_listener(state_);
         }
     }
 
-    void Animation::SetCurrentTime(long msecs) {
-        msecs = std::max(msecs, 0L);
-        // Calculate new time and loop:
-        auto duration = GetDuration();
-        auto total_duration = duration <= 0 ? duration : (Animation::INFINITE == loop_count_ ? -1 : duration * loop_count_);
-        if (total_duration != -1) msecs = std::min(total_duration, msecs);
-        total_current_time_ = msecs;
-        // Update new values:
-        int old_loop = current_loop_;
-        current_loop_ = ((duration <= 0) ? 0 : (msecs / duration));
-        if (current_loop_ == loop_count_) {
+    Animation::LoopTime Animation::ToLoopTime(Duration time, Duration duration) const {
+        LoopTime result;
+        result.loop = ((duration <= Duration::zero()) ? 0 : int(time / duration));
+        if (result.loop == loop_count_) {
             // At the end loop
-            current_time_ = std::max(0L, duration);
-            current_loop_ = std::max(0, loop_count_ - 1);
+            result.time = std::max(Duration::zero(), duration);
+            result.loop = std::max(0, loop_count_ - 1);
+        } else if (direction_ == Direction::kForward) {
+            result.time = (duration <= Duration::zero()) ? time : (time % duration);
         } else {
-            if (direction_ == Direction::kForward) {
-                current_time_ = (duration <= 0) ? msecs : (msecs % duration);
-            } else {
-                current_time_ = (duration <= 0) ? msecs : ((msecs - 1) % duration) + 1;
-                if (current_time_ == duration) {
-                    --current_loop_;
-                }
+            // Loop times are in (0, duration] when running backwards
+            result.time = (duration <= Duration::zero()) ? time : ((time - Duration(1)) % duration) + Duration(1);
+            if (result.time == duration) {
+                --result.loop;
             }
         }
+        return result;
+    }
+
+    Animation::LoopTime Animation::LoopTimeAt(Duration elapsed) const {
+        LoopTime result;
+        LoopTimesAt(elapsed, Duration::zero(), 1, &result);
+        return result;
+    }
+
+    void Animation::LoopTimesAt(Duration first, Duration interval, size_t count, LoopTime *out) const {
+        const Duration duration = this->duration();
+        const Duration total = TotalDuration(duration);
+        const bool reverse = Direction::kReverse == direction_;
+        // Where SetState() rewinds a reverse animation to
+        const Duration origin = reverse ? ((-1 == loop_count_) ? duration : total) : Duration::zero();
+        for (size_t i = 0; i < count; ++i) {
+            const Duration elapsed = first + interval * long(i);
+            Duration time = std::max(reverse ? origin - elapsed : elapsed, Duration::zero());
+            if (total != Duration(-1)) time = std::min(total, time);
+            out[i] = ToLoopTime(time, duration);
+        }
+    }
+
+    void Animation::SetCurrentTime(Duration time) {
+        time = std::max(time, Duration::zero());
+        // Calculate new time and loop:
+        const Duration total = total_duration();
+        if (total != Duration(-1)) time = std::min(total, time);
+        total_current_time_ = time;
+        // Update new values:
+        int old_loop = current_loop_;
+        const LoopTime loop_time = ToLoopTime(time);
+        current_time_ = loop_time.time;
+        current_loop_ = loop_time.loop;
 
         UpdateCurrentTime(current_time_);
         if (current_loop_ != old_loop) {
-            if (listeners_) {
-                // TODO: notify to listeners
-            }
+            NotifyListeners(&AnimationListener::OnAnimationRepeat);
         }
 
-        if ((direction_ == Direction::kForward && total_current_time_ == total_duration)
-        || (direction_ == Direction::kReverse && total_current_time_ == 0L)) {
+        if ((direction_ == Direction::kForward && total_current_time_ == total)
+        || (direction_ == Direction::kReverse && total_current_time_ == Duration::zero())) {
             Stop();
         }
     }
 
-    void Animation::UpdateAnimationFrame(long frame_time)
+    void Animation::UpdateAnimationFrame(Duration frame_time)
     {
-        if (state_ == State::kStopped || -1L == last_update_time_) {
+        if (state_ == State::kStopped || Duration(-1) == last_update_time_) {
             state_ = State::kRunning;
-            last_update_time_ = start_time_ = frame_time;
+            // A delayed animation begins when the frame time reaches its start time
+            last_update_time_ = frame_time + (delay_pending_ ? start_delay() : Duration::zero());
+            delay_pending_ = 0;
         }
-
-        if (paused_) {
-            if (pause_time_ < 0)
-            {
-                pause_time_ = frame_time;
-            }
-        } else if (resumed_) {
-            resumed_ = false;
-            if (pause_time_ > 0) {
-                const long paused_duration = (frame_time - pause_time_);
-                start_time_ += paused_duration;
-                last_update_time_ = paused_duration;
-            }
+        if (frame_time < last_update_time_) {
+            // Still within the start delay
+            return;
         }
 
-        // const long current_time = std::max(frame_time, start_time_);
-        const long delta = frame_time - last_update_time_;
+        const Duration delta = frame_time - last_update_time_;
         last_update_time_ = frame_time;
-        if (delta > 0) {
+        if (delta > Duration::zero()) {
             SetCurrentTime(total_current_time_ + (Direction::kForward == direction_ ? delta : -delta));
         }
     }
@@ -0,0 +1,51 @@
+/**
+ * @file cc_animation_baker.cc
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#include "cc_animation_baker.hpp"
+#include "worker_pool.h"
+
+namespace anim
+{
+    AnimationBaker::AnimationBaker() {
+    }
+
+    AnimationBaker::~AnimationBaker() {
+    }
+
+    void AnimationBaker::set_thread_count(int count) {
+        if (count == thread_count()) return;
+        pool_.reset(count > 1 ? new WorkerPool(count) : nullptr);
+    }
+
+    int AnimationBaker::thread_count() const {
+        return pool_ ? pool_->thread_count() : 1;
+    }
+
+    size_t AnimationBaker::FrameCount(const Animation &animation, Duration interval) {
+        const Duration total = animation.total_duration();
+        if (total < Duration::zero() || interval <= Duration::zero()) return 0;
+        return size_t(total / interval) + 1;
+    }
+
+    void AnimationBaker::Run(size_t count, const std::function<void(size_t)> &task) {
+        if (pool_ && count > 1) {
+            pool_->Run(count, task);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+    }
+} // namespace anim
@@ -0,0 +1,121 @@
+/**
+ * @file cc_animation_batch.cc
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#include <algorithm>
+#include "cc_animation_batch.hpp"
+
+namespace anim
+{
+    namespace
+    {
+        struct CurveTable
+        {
+            CurveTable() {
+                for (int i = 0; i < kCurveTypeCount; ++i) {
+                    curves[i] = EasingCurve(CurveType(i));
+                }
+            }
+            EasingCurve curves[kCurveTypeCount];
+        };
+
+        const EasingCurve *GetCurveTable() {
+            static const CurveTable table;
+            return table.curves;
+        }
+    }
+
+    size_t FloatAnimationBatch::Add(float start_value, float end_value, long duration, CurveType curve) {
+        times_.push_back(0L);
+        durations_.push_back(std::max(duration, 0L));
+        start_values_.push_back(start_value);
+        end_values_.push_back(end_value);
+        // Out of range types ease like Custom curves without a function, linearly
+        curves_.push_back(uint8_t(int(curve) >= 0 && int(curve) < kCurveTypeCount ? curve : CurveType::Custom));
+        return times_.size() - 1;
+    }
+
+    void FloatAnimationBatch::Reserve(size_t count) {
+        times_.reserve(count);
+        durations_.reserve(count);
+        start_values_.reserve(count);
+        end_values_.reserve(count);
+        curves_.reserve(count);
+    }
+
+    void FloatAnimationBatch::Clear() {
+        times_.clear();
+        durations_.clear();
+        start_values_.clear();
+        end_values_.clear();
+        curves_.clear();
+    }
+
+    void FloatAnimationBatch::SetCurrentTime(size_t index, long msecs) {
+        times_[index] = std::min(std::max(msecs, 0L), durations_[index]);
+    }
+
+    // Small enough to stay in L1, so the steps of AdvanceBlock() are still one pass over memory
+    static const size_t kBlockSize = 256;
+
+    void FloatAnimationBatch::Advance(long delta, float *out) {
+        const size_t count = times_.size();
+        for (size_t begin = 0; begin < count; begin += kBlockSize) {
+            AdvanceBlock(begin, std::min(begin + kBlockSize, count), delta, out + begin);
+        }
+    }
+
+    void FloatAnimationBatch::Advance(long delta, float *out, size_t stride) {
+        if (sizeof(float) == stride) {
+            Advance(delta, out);
+            return;
+        }
+        float values[kBlockSize];
+        char *target = reinterpret_cast<char *>(out);
+        const size_t count = times_.size();
+        for (size_t begin = 0; begin < count; begin += kBlockSize) {
+            const size_t size = std::min(kBlockSize, count - begin);
+            AdvanceBlock(begin, begin + size, delta, values);
+            for (size_t i = 0; i < size; ++i, target += stride) {
+                *reinterpret_cast<float *>(target) = values[i];
+            }
+        }
+    }
+
+    void FloatAnimationBatch::AdvanceBlock(size_t begin, size_t end, long delta, float *values) {
+        const EasingCurve *curves = GetCurveTable();
+        long *times = times_.data();
+        const long *durations = durations_.data();
+        const float *start_values = start_values_.data();
+        const float *end_values = end_values_.data();
+        const uint8_t *curve_ids = curves_.data();
+        for (size_t i = begin; i < end; ++i) {
+            const long duration = durations[i];
+            const long time = std::min(std::max(times[i] + delta, 0L), duration);
+            times[i] = time;
+            values[i - begin] = (duration == 0) ? 1.0f : float(time) / float(duration);
+        }
+        // Ease runs of entries sharing a curve with one call
+        for (size_t i = begin; i < end;) {
+            size_t run_end = i + 1;
+            while (run_end < end && curve_ids[run_end] == curve_ids[i]) ++run_end;
+            curves[curve_ids[i]].ValuesForProgress(values + (i - begin), values + (i - begin), run_end - i);
+            i = run_end;
+        }
+        // Same expression as ValueAnimation::SetCurrentValueForProgress() for the [0, 1] interval
+        for (size_t i = begin; i < end; ++i) {
+            values[i - begin] = start_values[i] + (end_values[i] - start_values[i]) * values[i - begin];
+        }
+    }
+} // namespace anim
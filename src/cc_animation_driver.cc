@@ -0,0 +1,224 @@
+/**
+ * @file cc_animation_driver.cc
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#include <algorithm>
+#include <chrono>
+#include "cc_animation.hpp"
+#include "cc_animation_driver.hpp"
+#include "cc_change_log.hpp"
+#include "command_queue.h"
+#include "worker_pool.h"
+
+namespace anim
+{
+    AnimationDriver::AnimationDriver() : commands_(new CommandQueue<PostedCommand>()) {
+    }
+
+    AnimationDriver::~AnimationDriver() {
+        // Detach whatever is still registered, so the animations don't try to unregister later
+        for (auto animation : animations_) {
+            if (animation) animation->driver_slot_ = -1;
+        }
+    }
+
+    AnimationDriver &AnimationDriver::GetInstance() {
+        static thread_local AnimationDriver instance;
+        return instance;
+    }
+
+    Duration AnimationDriver::Clock() {
+        using namespace std::chrono;
+        return duration_cast<Duration>(steady_clock::now().time_since_epoch());
+    }
+
+    long AnimationDriver::Now() {
+        return (long)std::chrono::duration_cast<std::chrono::milliseconds>(Clock()).count();
+    }
+
+    void AnimationDriver::RegisterAnimation(Animation *animation) {
+        if (animation->driver_slot_ >= 0) return;
+        animation->driver_slot_ = int32_t(animations_.size());
+        animations_.push_back(animation);
+        // Animations registered while ticking are seen by the caller of Tick()
+        if (wakeup_ && !ticking_ && !woken_) {
+            woken_ = true;
+            wakeup_();
+        }
+    }
+
+    void AnimationDriver::UnregisterAnimation(Animation *animation) {
+        const int32_t slot = animation->driver_slot_;
+        if (slot < 0) return;
+        animation->driver_slot_ = -1;
+        if (ticking_) {
+            // Keep the indices stable while iterating, the hole is removed by Compact()
+            animations_[slot] = nullptr;
+            ++removed_count_;
+            return;
+        }
+        Animation *last = animations_.back();
+        animations_.pop_back();
+        if (last != animation) {
+            animations_[slot] = last;
+            last->driver_slot_ = slot;
+        }
+    }
+
+    void AnimationDriver::NotifyAnimationEnd(Animation *animation) {
+        for (auto observer : tick_observers_) {
+            observer->OnAnimationEnd(*animation);
+        }
+    }
+
+    void AnimationDriver::Tick() {
+        Tick(Clock());
+    }
+
+    void AnimationDriver::set_thread_count(int count) {
+        if (count == thread_count()) return;
+        pool_.reset(count > 1 ? new WorkerPool(count) : nullptr);
+    }
+
+    int AnimationDriver::thread_count() const {
+        return pool_ ? pool_->thread_count() : 1;
+    }
+
+    void AnimationDriver::Post(Animation *animation, Command command) {
+        commands_->Push(PostedCommand{animation, command});
+        if (wakeup_) wakeup_();
+    }
+
+    bool AnimationDriver::HasPostedCommands() const {
+        return !commands_->IsEmpty();
+    }
+
+    Duration AnimationDriver::NextDeadline() const {
+        if (HasPostedCommands()) return Duration::min();
+        if (Duration::min() == last_frame_time_) {
+            return IsIdle() ? Duration::max() : Duration::min();
+        }
+        Duration deadline = Duration::max();
+        for (auto animation : animations_) {
+            if (nullptr == animation) continue;
+            // Stamped with a start time after the last frame, see Animation::UpdateAnimationFrame()
+            const Duration start = animation->last_update_time_;
+            if (start <= last_frame_time_) {
+                return last_frame_time_ + frame_interval_;
+            }
+            deadline = std::min(deadline, start);
+        }
+        return deadline;
+    }
+
+    void AnimationDriver::RunPostedCommands() {
+        PostedCommand posted;
+        while (commands_->Pop(&posted)) {
+            Animation *animation = posted.animation;
+            switch (posted.command) {
+            case Command::kStart: animation->Start(); break;
+            case Command::kStop: animation->Stop(); break;
+            case Command::kPause: animation->Pause(); break;
+            case Command::kResume: animation->Resume(); break;
+            case Command::kCancel: animation->Cancel(); break;
+            }
+        }
+    }
+
+    void AnimationDriver::AddTickObserver(TickObserver *observer) {
+        if (std::find(tick_observers_.begin(), tick_observers_.end(), observer) == tick_observers_.end()) {
+            tick_observers_.push_back(observer);
+        }
+    }
+
+    void AnimationDriver::RemoveTickObserver(TickObserver *observer) {
+        tick_observers_.erase(std::remove(tick_observers_.begin(), tick_observers_.end(), observer),
+                              tick_observers_.end());
+    }
+
+    void AnimationDriver::AddChangeLog(FrameLog *log) {
+        AddTickObserver(log);
+    }
+
+    void AnimationDriver::RemoveChangeLog(FrameLog *log) {
+        RemoveTickObserver(log);
+    }
+
+    void AnimationDriver::Tick(Duration frame_time) {
+        last_frame_time_ = frame_time;
+        woken_ = false;
+        for (auto observer : tick_observers_) {
+            observer->OnTickBegin(frame_time);
+        }
+        if (!commands_->IsEmpty()) {
+            RunPostedCommands();
+        }
+        // Not worth waking the workers for a single chunk
+        if (pool_ && animations_.size() > chunk_size_) {
+            TickParallel(frame_time);
+            return;
+        }
+        ticking_ = true;
+        const size_t count = animations_.size();
+        for (size_t i = 0; i < count; ++i) {
+            Animation *animation = animations_[i];
+            if (animation) {
+                animation->UpdateAnimationFrame(frame_time);
+            }
+        }
+        ticking_ = false;
+        if (removed_count_ > 0) {
+            Compact();
+        }
+    }
+
+    void AnimationDriver::TickParallel(Duration frame_time) {
+        ticking_ = true;
+        const size_t count = animations_.size();
+        const size_t chunk_count = (count + chunk_size_ - 1) / chunk_size_;
+        if (deferred_.size() < chunk_count) deferred_.resize(chunk_count);
+        pool_->Run(chunk_count, [this, frame_time, count](size_t chunk) {
+            Animation::SetDeferredAnimations(&deferred_[chunk]);
+            const size_t end = std::min(count, (chunk + 1) * chunk_size_);
+            for (size_t i = chunk * chunk_size_; i < end; ++i) {
+                animations_[i]->UpdateAnimationFrame(frame_time);
+            }
+            Animation::SetDeferredAnimations(nullptr);
+        });
+        // Chunks in order, and animations in the order they raised notifications within a chunk,
+        // the same order as a serial tick
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            for (auto animation : deferred_[chunk]) {
+                animation->DeliverPendingNotifications();
+            }
+            deferred_[chunk].clear();
+        }
+        ticking_ = false;
+        if (removed_count_ > 0) {
+            Compact();
+        }
+    }
+
+    void AnimationDriver::Compact() {
+        size_t out = 0;
+        for (size_t i = 0; i < animations_.size(); ++i) {
+            Animation *animation = animations_[i];
+            if (nullptr == animation) continue;
+            animation->driver_slot_ = int32_t(out);
+            animations_[out++] = animation;
+        }
+        animations_.resize(out);
+        removed_count_ = 0;
+    }
+} // namespace anim
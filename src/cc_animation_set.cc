@@ -0,0 +1,199 @@
+/**
+ * @file cc_animation_set.cc
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#include <algorithm>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_set.hpp"
+
+namespace anim
+{
+    const Duration AnimationSet::kForever = Duration::max();
+
+    AnimationSet::~AnimationSet() {
+        for (auto animation : animations_) {
+            animation->set_group(nullptr);
+        }
+    }
+
+    void AnimationSet::AddAnimation(Animation *animation) {
+        if (nullptr == animation || this == animation || this == animation->group()) return;
+        if (AnimationSet *group = animation->group()) {
+            group->RemoveAnimation(animation);
+        }
+        // From now on the group drives it
+        animation->driver()->UnregisterAnimation(animation);
+        animation->set_group(this);
+        animations_.push_back(animation);
+        timeline_dirty_ = true;
+    }
+
+    void AnimationSet::RemoveAnimation(Animation *animation) {
+        auto it = std::find(animations_.begin(), animations_.end(), animation);
+        if (it == animations_.end()) return;
+        animations_.erase(it);
+        animation->set_group(nullptr);
+        if (State::kRunning == animation->state()) {
+            animation->driver()->RegisterAnimation(animation);
+        }
+        timeline_dirty_ = true;
+    }
+
+    void AnimationSet::ClearAnimations() {
+        while (!animations_.empty()) {
+            RemoveAnimation(animations_.back());
+        }
+    }
+
+    Duration AnimationSet::ComputeDuration() const {
+        Duration duration{0};
+        for (auto animation : animations_) {
+            const Duration total = animation->total_duration();
+            if (total < Duration::zero()) return Duration(-1);
+            duration = (Ordering::kSequential == ordering_) ? duration + total : std::max(duration, total);
+        }
+        return duration;
+    }
+
+    Duration AnimationSet::duration() const {
+        return timeline_dirty_ ? ComputeDuration() : duration_;
+    }
+
+    void AnimationSet::Flatten() {
+        const std::vector<TimelineEntry> previous = timeline_dirty_ ? std::vector<TimelineEntry>() : timeline_;
+        timeline_.clear();
+        timeline_.reserve(animations_.size());
+        Duration offset{0};
+        for (auto animation : animations_) {
+            // Children play in the direction of the group
+            animation->set_direction(direction());
+            const Duration total = animation->total_duration();
+            const Duration length = total < Duration::zero() ? kForever : total;
+            if (Ordering::kSequential == ordering_) {
+                // Nothing after a child that loops forever is ever reached
+                const Duration end = (kForever == offset || kForever == length) ? kForever : offset + length;
+                timeline_.push_back(TimelineEntry{offset, end, animation});
+                offset = end;
+            } else {
+                timeline_.push_back(TimelineEntry{Duration::zero(), length, animation});
+            }
+        }
+        if (Ordering::kParallel == ordering_) {
+            // All start at 0, so sorting on the end keeps the starts sorted too
+            std::stable_sort(timeline_.begin(), timeline_.end(),
+                             [](const TimelineEntry &a, const TimelineEntry &b) { return a.end < b.end; });
+        }
+        duration_ = ComputeDuration();
+        timeline_dirty_ = false;
+        // The children are still where the last update left them if nothing moved
+        const bool unchanged = previous.size() == timeline_.size()
+            && std::equal(previous.begin(), previous.end(), timeline_.begin(),
+                          [](const TimelineEntry &a, const TimelineEntry &b) {
+                              return a.start == b.start && a.end == b.end && a.animation == b.animation;
+                          });
+        if (!unchanged) last_time_ = Duration(-1);
+    }
+
+    void AnimationSet::Move(Duration from, Duration to) {
+        auto end_after = [](Duration time, const TimelineEntry &entry) { return time < entry.end; };
+        auto start_after = [](Duration time, const TimelineEntry &entry) { return time < entry.start; };
+        if (from < to) {
+            // Children that ended in (from, to] are settled on their end, in timeline order
+            auto first = std::upper_bound(timeline_.begin(), timeline_.end(), from, end_after);
+            auto last = std::upper_bound(first, timeline_.end(), to, end_after);
+            for (auto it = first; it != last; ++it) {
+                it->animation->SetCurrentTime(it->end - it->start);
+            }
+        } else if (to < from) {
+            // Children that started in (to, from] are settled on their start, latest first
+            auto first = std::upper_bound(timeline_.begin(), timeline_.end(), to, start_after);
+            auto last = std::upper_bound(first, timeline_.end(), from, start_after);
+            for (auto it = last; it != first;) {
+                --it;
+                it->animation->SetCurrentTime(Duration::zero());
+            }
+        }
+        // The children active at `to` follow the ones ending before them
+        for (auto it = std::upper_bound(timeline_.begin(), timeline_.end(), to, end_after);
+             it != timeline_.end() && it->start <= to; ++it) {
+            Animation *animation = it->animation;
+            if (State::kStopped == animation->state()) {
+                animation->Start();
+            }
+            animation->SetCurrentTime(to - it->start);
+        }
+    }
+
+    void AnimationSet::UpdateCurrentTime(Duration current_time) {
+        if (timeline_dirty_) {
+            Flatten();
+        }
+        if (restarted_) {
+            // Not a new loop, the children are rewound straight from wherever they are
+            last_loop_ = current_loop_;
+            restarted_ = false;
+        }
+        if (last_time_ >= Duration::zero() && current_loop_ != last_loop_ && duration_ > Duration::zero()) {
+            // Finish the loop being left, then move the children to where the new one begins: the
+            // other end of the timeline when restarting, the same end when reversing
+            const bool forward = current_loop_ > last_loop_;
+            const Duration loop_end = TimelineTime(forward ? duration_ : Duration::zero(), last_loop_);
+            const Duration loop_begin = TimelineTime(forward ? Duration::zero() : duration_, current_loop_);
+            Move(last_time_, loop_end);
+            Move(loop_end, loop_begin);
+            last_time_ = loop_begin;
+        }
+        const Duration time = TimelineTime(current_time, current_loop_);
+        Move(last_time_, time);
+        last_time_ = time;
+        last_loop_ = current_loop_;
+    }
+
+    void AnimationSet::Start() {
+        if (State::kRunning == state()) return;
+        // Pick up changes to the durations of the children
+        Flatten();
+        restarted_ = true;
+        Animation::Start();
+    }
+
+    void AnimationSet::Stop() {
+        for (auto animation : animations_) {
+            if (State::kStopped != animation->state()) animation->Stop();
+        }
+        Animation::Stop();
+    }
+
+    void AnimationSet::Cancel() {
+        for (auto animation : animations_) {
+            if (State::kStopped != animation->state()) animation->Cancel();
+        }
+        Animation::Cancel();
+    }
+
+    void AnimationSet::Pause() {
+        for (auto animation : animations_) {
+            if (State::kRunning == animation->state()) animation->Pause();
+        }
+        Animation::Pause();
+    }
+
+    void AnimationSet::Resume() {
+        if (State::kPaused != state()) return;
+        for (auto animation : animations_) {
+            if (State::kPaused == animation->state()) animation->Resume();
+        }
+        Animation::Resume();
+    }
+} // namespace anim
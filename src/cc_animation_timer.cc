@@ -0,0 +1,78 @@
+/**
+ * @file cc_animation_timer.cc
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#include "cc_animation_timer.hpp"
+
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <cstdint>
+
+namespace anim
+{
+    namespace
+    {
+        // Fires right away, an all-zero it_value would disarm the timer instead
+        void FireNow(int fd) {
+            itimerspec spec = {};
+            spec.it_value.tv_nsec = 1;
+            timerfd_settime(fd, 0, &spec, nullptr);
+        }
+    }
+
+    AnimationTimer::AnimationTimer(AnimationDriver *driver)
+        : driver_(driver), fd_(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) {
+        if (fd_ < 0) return;
+        const int fd = fd_;
+        // Only makes a syscall, so it is safe from the threads posting commands
+        driver_->set_wakeup_callback([fd] { FireNow(fd); });
+        Arm();
+    }
+
+    AnimationTimer::~AnimationTimer() {
+        if (fd_ < 0) return;
+        driver_->set_wakeup_callback(nullptr);
+        close(fd_);
+    }
+
+    void AnimationTimer::OnReadable() {
+        uint64_t expirations = 0;
+        if (read(fd_, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            driver_->Tick(AnimationDriver::Clock());
+        }
+        Arm();
+    }
+
+    void AnimationTimer::Arm() {
+        if (fd_ < 0) return;
+        const Duration deadline = driver_->NextDeadline();
+        if (Duration::min() == deadline) {
+            FireNow(fd_);
+            return;
+        }
+        itimerspec spec = {};
+        if (Duration::max() != deadline) {
+            // steady_clock, which Clock() reads, is CLOCK_MONOTONIC
+            const long long ns = deadline.count() > 0 ? (long long)deadline.count() : 1LL;
+            spec.it_value.tv_sec = time_t(ns / 1000000000LL);
+            spec.it_value.tv_nsec = long(ns % 1000000000LL);
+        }
+        timerfd_settime(fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+        // A command posted after NextDeadline() looked at the queue may have fired the timer before
+        // the line above armed it for later
+        if (driver_->HasPostedCommands()) FireNow(fd_);
+    }
+} // namespace anim
+#endif
@@ -0,0 +1,329 @@
+/**
+ * @file cc_clip_file.cc
+ * @brief
+ * @version 0.1
+ * @date 2022-02-13
+ *
+ * @copyright Copyright (c) 2022 Kane Dong
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ **/
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include "cc_clip_file.hpp"
+#include "clip_format.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CC_CLIP_FILE_MMAP 1
+#endif
+
+namespace anim
+{
+    using clip_format::ClipRecord;
+    using clip_format::Header;
+    using clip_format::NameSlot;
+
+    namespace
+    {
+        // Whether count elements of size bytes at offset fit in a file of file_size bytes
+        bool InRange(uint64_t offset, uint64_t count, uint64_t size, uint64_t file_size) {
+            if (offset > file_size) return false;
+            return 0 == size || count <= (file_size - offset) / size;
+        }
+
+        bool IsAligned(uint64_t offset, uint64_t alignment) {
+            return 0 == offset % alignment;
+        }
+
+        uint64_t AlignUp(uint64_t offset) {
+            const uint64_t alignment = clip_format::kArrayAlignment;
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        const ClipRecord &RecordAt(const void *directory, size_t index) {
+            return static_cast<const ClipRecord *>(directory)[index];
+        }
+
+        const NameSlot &SlotAt(const void *slots, size_t index) {
+            return static_cast<const NameSlot *>(slots)[index];
+        }
+
+        // The smallest power of 2 at least twice the clip count, so probes stop early on an empty slot
+        uint32_t NameSlotCount(size_t clip_count) {
+            uint32_t count = 1;
+            while (count < 2 * clip_count) {
+                count *= 2;
+            }
+            return count;
+        }
+    } // namespace
+
+    bool ClipFile::Open(const std::string &path) {
+        Close();
+#if defined(CC_CLIP_FILE_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat info;
+        void *data = MAP_FAILED;
+        if (0 == ::fstat(fd, &info) && size_t(info.st_size) >= sizeof(Header)) {
+            data = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        // The mapping stays valid after closing the descriptor
+        ::close(fd);
+        if (MAP_FAILED == data) return false;
+        data_ = static_cast<const char *>(data);
+        size_ = size_t(info.st_size);
+        mapped_ = true;
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return false;
+        const std::streamoff size = in.tellg();
+        if (size < std::streamoff(sizeof(Header))) return false;
+        buffer_.resize(size_t(size));
+        in.seekg(0);
+        if (!in.read(buffer_.data(), size)) {
+            buffer_.clear();
+            return false;
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+        if (!Validate()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool ClipFile::OpenMemory(const void *data, size_t size) {
+        Close();
+        if (nullptr == data || size < sizeof(Header)) return false;
+        data_ = static_cast<const char *>(data);
+        size_ = size;
+        if (!Validate()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void ClipFile::Close() {
+#if defined(CC_CLIP_FILE_MMAP)
+        if (mapped_) ::munmap(const_cast<char *>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+        clip_count_ = 0;
+        directory_ = nullptr;
+        name_slots_ = nullptr;
+        name_slot_count_ = 0;
+        indexes_.reset();
+    }
+
+    bool ClipFile::Validate() {
+        if (!IsAligned(reinterpret_cast<uintptr_t>(data_), clip_format::kArrayAlignment)) return false;
+        Header header;
+        std::memcpy(&header, data_, sizeof(header));
+        if (0 != std::memcmp(header.magic, clip_format::kMagic, sizeof(header.magic))
+            || kVersion != header.version || clip_format::kByteOrderMark != header.byte_order
+            || header.file_size != size_
+            || !IsAligned(header.directory_offset, alignof(ClipRecord))
+            || !InRange(header.directory_offset, header.clip_count, sizeof(ClipRecord), size_)
+            || header.name_slot_count <= header.clip_count
+            || 0 != (header.name_slot_count & (header.name_slot_count - 1))
+            || !IsAligned(header.name_slots_offset, alignof(NameSlot))
+            || !InRange(header.name_slots_offset, header.name_slot_count, sizeof(NameSlot), size_)) {
+            return false;
+        }
+        const void *directory = data_ + header.directory_offset;
+        // Only the directory is read here, so opening does not page in the keyframes. The name
+        // slots are checked by FindClip() when probed
+        indexes_.reset(new BakedClipIndex[header.clip_count]);
+        const char *previous_name = nullptr;
+        for (size_t i = 0; i < header.clip_count; ++i) {
+            const ClipRecord &clip = RecordAt(directory, i);
+            if (!InRange(clip.name_offset, uint64_t(clip.name_size) + 1, 1, size_)
+                || '\0' != data_[clip.name_offset + clip.name_size]) {
+                return false;
+            }
+            // Sorted, so every name is unique
+            const char *name = data_ + clip.name_offset;
+            if (previous_name && std::strcmp(previous_name, name) >= 0) return false;
+            previous_name = name;
+            const uint64_t count = clip.keyframe_count;
+            if (count < 2 || 0 == clip.value_size
+                || !IsAligned(clip.progress_offset, alignof(float))
+                || !InRange(clip.progress_offset, count, sizeof(float), size_)
+                || !InRange(clip.values_offset, count, clip.value_size, size_)) {
+                return false;
+            }
+            if (0 != clip.curves_offset && (!IsAligned(clip.curves_offset, alignof(CurveRecord))
+                || !InRange(clip.curves_offset, count - 1, sizeof(CurveRecord), size_))) {
+                return false;
+            }
+            if (0 != clip.bucket_count && (!IsAligned(clip.buckets_offset, alignof(uint32_t))
+                || !InRange(clip.buckets_offset, clip.bucket_count, sizeof(uint32_t), size_))) {
+                return false;
+            }
+            const uint32_t *buckets = reinterpret_cast<const uint32_t *>(data_ + clip.buckets_offset);
+            const CurveRecord *curves = clip.curves_offset
+                ? reinterpret_cast<const CurveRecord *>(data_ + clip.curves_offset) : nullptr;
+            indexes_[i].Attach(buckets, clip.bucket_count, clip.bucket_start, clip.bucket_scale, curves, count);
+        }
+        clip_count_ = header.clip_count;
+        directory_ = directory;
+        name_slots_ = data_ + header.name_slots_offset;
+        name_slot_count_ = header.name_slot_count;
+        return true;
+    }
+
+    const char *ClipFile::clip_name(size_t index) const {
+        if (index >= clip_count_) return nullptr;
+        return data_ + RecordAt(directory_, index).name_offset;
+    }
+
+    long ClipFile::FindClip(const char *name) const {
+        if (0 == name_slot_count_) return -1;
+        const uint32_t hash = clip_format::HashName(name);
+        const uint32_t mask = name_slot_count_ - 1;
+        uint32_t slot = hash & mask;
+        // Bounded by the slot count, should a damaged table have no empty slot
+        for (uint32_t probe = 0; probe <= mask; ++probe, slot = (slot + 1) & mask) {
+            const NameSlot &entry = SlotAt(name_slots_, slot);
+            if (clip_format::kNoClip == entry.clip) return -1;
+            if (hash == entry.hash && entry.clip < clip_count_ && 0 == std::strcmp(clip_name(entry.clip), name)) {
+                return long(entry.clip);
+            }
+        }
+        return -1;
+    }
+
+    bool ClipFile::GetClipData(size_t index, uint32_t value_type, size_t value_size, size_t value_align,
+                               BakedClip<void> *clip) const {
+        if (index >= clip_count_) return false;
+        const ClipRecord &record = RecordAt(directory_, index);
+        if (record.value_type != value_type || record.value_size != value_size
+            || !IsAligned(record.values_offset, value_align)) {
+            return false;
+        }
+        clip->progress = reinterpret_cast<const float *>(data_ + record.progress_offset);
+        clip->values = data_ + record.values_offset;
+        clip->count = record.keyframe_count;
+        clip->duration = std::chrono::nanoseconds(record.duration_ns);
+        clip->index = &indexes_[index];
+        return true;
+    }
+
+    bool ClipWriter::AddPendingClip(PendingClip clip) {
+        if (!names_.insert(clip.name).second) return false;
+        clips_.push_back(std::move(clip));
+        return true;
+    }
+
+    std::vector<char> ClipWriter::Serialize() const {
+        // The directory is sorted by name, the arrays follow in the same order
+        std::vector<size_t> order(clips_.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return std::strcmp(clips_[a].name.c_str(), clips_[b].name.c_str()) < 0;
+        });
+
+        std::vector<ClipRecord> directory(clips_.size());
+        std::vector<NameSlot> name_slots(NameSlotCount(clips_.size()), NameSlot{0, clip_format::kNoClip});
+        const uint32_t mask = uint32_t(name_slots.size() - 1);
+        for (size_t i = 0; i < order.size(); ++i) {
+            const uint32_t hash = clip_format::HashName(clips_[order[i]].name.c_str());
+            uint32_t slot = hash & mask;
+            while (clip_format::kNoClip != name_slots[slot].clip) {
+                slot = (slot + 1) & mask;
+            }
+            name_slots[slot].hash = hash;
+            name_slots[slot].clip = uint32_t(i);
+        }
+        const uint64_t name_slots_offset = AlignUp(sizeof(Header) + directory.size() * sizeof(ClipRecord));
+        uint64_t offset = name_slots_offset + name_slots.size() * sizeof(NameSlot);
+        for (size_t i = 0; i < order.size(); ++i) {
+            const PendingClip &clip = clips_[order[i]];
+            ClipRecord &record = directory[i];
+            std::memset(&record, 0, sizeof(record));
+            record.name_offset = offset;
+            record.name_size = uint32_t(clip.name.size());
+            offset += clip.name.size() + 1;
+        }
+        for (size_t i = 0; i < order.size(); ++i) {
+            const PendingClip &clip = clips_[order[i]];
+            ClipRecord &record = directory[i];
+            record.value_type = clip.value_type;
+            record.value_size = clip.value_size;
+            record.keyframe_count = uint32_t(clip.progress.size());
+            record.bucket_count = uint32_t(clip.buckets.size());
+            record.bucket_start = clip.bucket_start;
+            record.bucket_scale = clip.bucket_scale;
+            record.duration_ns = clip.duration_ns;
+            record.progress_offset = offset = AlignUp(offset);
+            offset += clip.progress.size() * sizeof(float);
+            record.values_offset = offset = AlignUp(offset);
+            offset += clip.values.size();
+            if (!clip.curves.empty()) {
+                record.curves_offset = offset = AlignUp(offset);
+                offset += clip.curves.size() * sizeof(CurveRecord);
+            }
+            if (!clip.buckets.empty()) {
+                record.buckets_offset = offset = AlignUp(offset);
+                offset += clip.buckets.size() * sizeof(uint32_t);
+            }
+        }
+
+        std::vector<char> file(offset, 0);
+        Header header;
+        std::memcpy(header.magic, clip_format::kMagic, sizeof(header.magic));
+        header.version = ClipFile::kVersion;
+        header.byte_order = clip_format::kByteOrderMark;
+        header.clip_count = uint32_t(directory.size());
+        header.file_size = offset;
+        header.directory_offset = sizeof(Header);
+        header.name_slots_offset = name_slots_offset;
+        header.name_slot_count = uint32_t(name_slots.size());
+        header.reserved = 0;
+        std::memcpy(file.data(), &header, sizeof(header));
+        if (!directory.empty()) {
+            std::memcpy(file.data() + sizeof(Header), directory.data(), directory.size() * sizeof(ClipRecord));
+        }
+        std::memcpy(&file[name_slots_offset], name_slots.data(), name_slots.size() * sizeof(NameSlot));
+        for (size_t i = 0; i < order.size(); ++i) {
+            const PendingClip &clip = clips_[order[i]];
+            const ClipRecord &record = directory[i];
+            std::memcpy(&file[record.name_offset], clip.name.c_str(), clip.name.size() + 1);
+            std::memcpy(&file[record.progress_offset], clip.progress.data(), clip.progress.size() * sizeof(float));
+            std::memcpy(&file[record.values_offset], clip.values.data(), clip.values.size());
+            if (!clip.curves.empty()) {
+                std::memcpy(&file[record.curves_offset], clip.curves.data(), clip.curves.size() * sizeof(CurveRecord));
+            }
+            if (!clip.buckets.empty()) {
+                std::memcpy(&file[record.buckets_offset], clip.buckets.data(), clip.buckets.size() * sizeof(uint32_t));
+            }
+        }
+        return file;
+    }
+
+    bool ClipWriter::Write(const std::string &path) const {
+        const std::vector<char> file = Serialize();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(file.data(), std::streamsize(file.size()));
+        return bool(out.flush());
+    }
+} // namespace anim
@@ -1,87 +1,490 @@
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
 #include "cc_easing_curve.hpp"
 #include "easing.cc"
+#include "easing_simd.h"
 
 namespace anim
 {
-    static CurveFunction CurveToFunc(const CurveType &type)
+    using CurveArrayFunction = simd::ArrayKernel;
+    using simd::CurveParameters;
+
+    struct CurveKernels
+    {
+        CurveFunction func;
+        CurveArrayFunction array_func;
+    };
+
+    // Loops over the curve with the call inlined, instead of going through the function pointer per value
+    template <CurveFunction F>
+    static void EaseArray(const float *progress, float *values, size_t count, const CurveParameters &)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = F(progress[i]);
+        }
+    }
+
+    template <CurveFunction F>
+    static CurveKernels Kernels()
+    {
+        return CurveKernels{F, &EaseArray<F>};
+    }
+
+    static inline bool IsParameterized(CurveType type)
+    {
+        return type >= CurveType::InElastic && type <= CurveType::OutInBounce;
+    }
+
+    static inline real ParameterizedValue(CurveType type, real t, const CurveParameters &params)
+    {
+        switch (type)
+        {
+        case CurveType::InElastic:
+            return easeInElastic(t, params.amplitude, params.period);
+        case CurveType::OutElastic:
+            return easeOutElastic(t, params.amplitude, params.period);
+        case CurveType::InOutElastic:
+            return easeInOutElastic(t, params.amplitude, params.period);
+        case CurveType::OutInElastic:
+            return easeOutInElastic(t, params.amplitude, params.period);
+        case CurveType::InBack:
+            return easeInBack(t, params.overshoot);
+        case CurveType::OutBack:
+            return easeOutBack(t, params.overshoot);
+        case CurveType::InOutBack:
+            return easeInOutBack(t, params.overshoot);
+        case CurveType::OutInBack:
+            return easeOutInBack(t, params.overshoot);
+        case CurveType::InBounce:
+            return easeInBounce(t, params.amplitude);
+        case CurveType::OutBounce:
+            return easeOutBounce(t, params.amplitude);
+        case CurveType::InOutBounce:
+            return easeInOutBounce(t, params.amplitude);
+        case CurveType::OutInBounce:
+            return easeOutInBounce(t, params.amplitude);
+        default:
+            return t;
+        }
+    }
+
+    // The switch in ParameterizedValue() folds away for a constant type
+    template <CurveType Type>
+    static void EaseParameterizedArray(const float *progress, float *values, size_t count, const CurveParameters &params)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = ParameterizedValue(Type, progress[i], params);
+        }
+    }
+
+    template <CurveType Type>
+    static CurveKernels ParameterizedKernels()
+    {
+        return CurveKernels{nullptr, &EaseParameterizedArray<Type>};
+    }
+
+    static CurveKernels CurveToKernels(const CurveType &type)
     {
         switch (type)
         {
         case CurveType::InQuad:
-            return &easeInQuad;
+            return Kernels<&easeInQuad>();
         case CurveType::OutQuad:
-            return &easeOutQuad;
+            return Kernels<&easeOutQuad>();
         case CurveType::InOutQuad:
-            return &easeInOutQuad;
+            return Kernels<&easeInOutQuad>();
         case CurveType::OutInQuad:
-            return &easeOutInQuad;
+            return Kernels<&easeOutInQuad>();
         case CurveType::InCubic:
-            return &easeInCubic;
+            return Kernels<&easeInCubic>();
         case CurveType::OutCubic:
-            return &easeOutCubic;
+            return Kernels<&easeOutCubic>();
         case CurveType::InOutCubic:
-            return &easeInOutCubic;
+            return Kernels<&easeInOutCubic>();
         case CurveType::OutInCubic:
-            return &easeOutInCubic;
+            return Kernels<&easeOutInCubic>();
         case CurveType::InQuart:
-            return &easeInQuart;
+            return Kernels<&easeInQuart>();
         case CurveType::OutQuart:
-            return &easeOutQuart;
+            return Kernels<&easeOutQuart>();
         case CurveType::InOutQuart:
-            return &easeInOutQuart;
+            return Kernels<&easeInOutQuart>();
         case CurveType::OutInQuart:
-            return &easeOutInQuart;
+            return Kernels<&easeOutInQuart>();
         case CurveType::InQuint:
-            return &easeInQuint;
+            return Kernels<&easeInQuint>();
         case CurveType::OutQuint:
-            return &easeOutQuint;
+            return Kernels<&easeOutQuint>();
         case CurveType::InOutQuint:
-            return &easeInOutQuint;
+            return Kernels<&easeInOutQuint>();
         case CurveType::OutInQuint:
-            return &easeOutInQuint;
+            return Kernels<&easeOutInQuint>();
         case CurveType::InSine:
-            return &easeInSine;
+            return Kernels<&easeInSine>();
         case CurveType::OutSine:
-            return &easeOutSine;
+            return Kernels<&easeOutSine>();
         case CurveType::InOutSine:
-            return &easeInOutSine;
+            return Kernels<&easeInOutSine>();
         case CurveType::OutInSine:
-            return &easeOutInSine;
+            return Kernels<&easeOutInSine>();
         case CurveType::InExpo:
-            return &easeInExpo;
+            return Kernels<&easeInExpo>();
         case CurveType::OutExpo:
-            return &easeOutExpo;
+            return Kernels<&easeOutExpo>();
         case CurveType::InOutExpo:
-            return &easeInOutExpo;
+            return Kernels<&easeInOutExpo>();
         case CurveType::OutInExpo:
-            return &easeOutInExpo;
+            return Kernels<&easeOutInExpo>();
         case CurveType::InCirc:
-            return &easeInCirc;
+            return Kernels<&easeInCirc>();
         case CurveType::OutCirc:
-            return &easeOutCirc;
+            return Kernels<&easeOutCirc>();
         case CurveType::InOutCirc:
-            return &easeInOutCirc;
+            return Kernels<&easeInOutCirc>();
         case CurveType::OutInCirc:
-            return &easeOutInCirc;
+            return Kernels<&easeOutInCirc>();
+        case CurveType::InElastic:
+            return ParameterizedKernels<CurveType::InElastic>();
+        case CurveType::OutElastic:
+            return ParameterizedKernels<CurveType::OutElastic>();
+        case CurveType::InOutElastic:
+            return ParameterizedKernels<CurveType::InOutElastic>();
+        case CurveType::OutInElastic:
+            return ParameterizedKernels<CurveType::OutInElastic>();
+        case CurveType::InBack:
+            return ParameterizedKernels<CurveType::InBack>();
+        case CurveType::OutBack:
+            return ParameterizedKernels<CurveType::OutBack>();
+        case CurveType::InOutBack:
+            return ParameterizedKernels<CurveType::InOutBack>();
+        case CurveType::OutInBack:
+            return ParameterizedKernels<CurveType::OutInBack>();
+        case CurveType::InBounce:
+            return ParameterizedKernels<CurveType::InBounce>();
+        case CurveType::OutBounce:
+            return ParameterizedKernels<CurveType::OutBounce>();
+        case CurveType::InOutBounce:
+            return ParameterizedKernels<CurveType::InOutBounce>();
+        case CurveType::OutInBounce:
+            return ParameterizedKernels<CurveType::OutInBounce>();
         case CurveType::InCurve:
-            return &easeInCurve;
+            return Kernels<&easeInCurve>();
         case CurveType::OutCurve:
-            return &easeOutCurve;
+            return Kernels<&easeOutCurve>();
         case CurveType::SineCurve:
-            return &easeSineCurve;
+            return Kernels<&easeSineCurve>();
         case CurveType::CosineCurve:
-            return &easeCosineCurve;
+            return Kernels<&easeCosineCurve>();
+        case CurveType::CubicBezier:
+            // Solved per value in EasingCurve::BezierValueForProgress()
+            return CurveKernels{nullptr, nullptr};
         case CurveType::Linear:
         default:
-            return &easeNone;
+            return Kernels<&easeNone>();
         };
     }
 
-    EasingCurve::EasingCurve(CurveType type) : func_(CurveToFunc(type)) {}
+    EasingCurve::EasingCurve(CurveType type) : type_(uint8_t(type)), flags_(kValid) {
+        if (CurveType::CubicBezier == type) {
+            *this = Bezier(0.25f, 0.1f, 0.25f, 1.0f);
+        }
+    }
+
+    // a, b, c of one coordinate of a bezier from the b, c stored in the curve
+    static inline void ExpandBezierCoefficients(const float *stored, float *coefficients) {
+        coefficients[0] = 1.0f - stored[1] - stored[0];
+        coefficients[1] = stored[0];
+        coefficients[2] = stored[1];
+    }
+
+    bool EasingCurve::ToRecord(CurveRecord *record) const {
+        if (CurveType::Custom == type()) return false;
+        record->type = int32_t(type_);
+        if (CurveType::CubicBezier == type()) {
+            ExpandBezierCoefficients(params_, record->params);
+            ExpandBezierCoefficients(params_ + 2, record->params + 3);
+        } else {
+            std::copy(params_, params_ + 3, record->params);
+            std::fill(record->params + 3, record->params + 6, 0.0f);
+        }
+        return true;
+    }
+
+    EasingCurve EasingCurve::FromRecord(const CurveRecord &record) {
+        EasingCurve curve;
+        if (record.type < 0 || record.type >= int32_t(CurveType::Custom)) return curve;
+        // Not through the constructor, which would compute the coefficients of the default bezier
+        curve.type_ = uint8_t(record.type);
+        curve.flags_ = kValid;
+        if (CurveType::CubicBezier == curve.type()) {
+            const float params[4] = {record.params[1], record.params[2], record.params[4], record.params[5]};
+            std::copy(params, params + 4, curve.params_);
+        } else {
+            std::copy(record.params, record.params + 3, curve.params_);
+        }
+        return curve;
+    }
+
+    // Polynomial ((a * t + b) * t + c) * t of one coordinate of a bezier from 0 to 1
+    static inline float BezierSample(const float *coefficients, float t) {
+        return ((coefficients[0] * t + coefficients[1]) * t + coefficients[2]) * t;
+    }
+
+    static inline float BezierSlope(const float *coefficients, float t) {
+        return (3.0f * coefficients[0] * t + 2.0f * coefficients[1]) * t + coefficients[2];
+    }
+
+    // b, c of one coordinate, a follows from the end point at 1
+    static void BezierCoefficients(float p1, float p2, float *stored) {
+        stored[1] = 3.0f * p1;
+        stored[0] = 3.0f * (p2 - p1) - stored[1];
+    }
+
+    struct BezierSampleTable
+    {
+        static const int kSize = 17;
+        // x at t = i / (kSize - 1), increasing as x1 and x2 are in [0, 1]
+        float x[kSize];
+
+        float Guess(float progress) const {
+            int i = 1;
+            while (i < kSize - 1 && x[i] <= progress) ++i;
+            const float span = x[i] - x[i - 1];
+            const float f = span > 0.0f ? (progress - x[i - 1]) / span : 0.0f;
+            return (float(i - 1) + f) / float(kSize - 1);
+        }
+    };
+
+    static const BezierSampleTable *GetBezierSampleTable(const float *x_coefficients)
+    {
+        // Tables are never released, curves keep plain pointers to them
+        using Key = std::array<float, 3>;
+        static std::mutex mutex;
+        static std::map<Key, std::unique_ptr<BezierSampleTable>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<BezierSampleTable> &table = tables[Key{{x_coefficients[0], x_coefficients[1], x_coefficients[2]}}];
+        if (table) return table.get();
+
+        table.reset(new BezierSampleTable);
+        for (int i = 0; i < BezierSampleTable::kSize; ++i) {
+            table->x[i] = BezierSample(x_coefficients, float(i) / float(BezierSampleTable::kSize - 1));
+        }
+        return table.get();
+    }
+
+    EasingCurve EasingCurve::Bezier(float x1, float y1, float x2, float y2, bool sample_table) {
+        EasingCurve curve;
+        curve.type_ = uint8_t(CurveType::CubicBezier);
+        curve.flags_ = kValid;
+        BezierCoefficients(std::min(std::max(x1, 0.0f), 1.0f), std::min(std::max(x2, 0.0f), 1.0f), curve.params_);
+        BezierCoefficients(y1, y2, curve.params_ + 2);
+        if (sample_table) {
+            float x[3];
+            ExpandBezierCoefficients(curve.params_, x);
+            curve.bezier_samples_ = GetBezierSampleTable(x);
+        }
+        return curve;
+    }
+
+    bool EasingCurve::GetControlPoints(float points[4]) const {
+        if (CurveType::CubicBezier != type()) return false;
+        // Inverse of BezierCoefficients(): c = 3 * p1, b = 3 * p2 - 6 * p1
+        points[0] = params_[1] / 3.0f;
+        points[1] = params_[3] / 3.0f;
+        points[2] = (params_[0] + 2.0f * params_[1]) / 3.0f;
+        points[3] = (params_[2] + 2.0f * params_[3]) / 3.0f;
+        return true;
+    }
+
+    float EasingCurve::BezierValueForProgress(float progress) const {
+        float x[3];
+        float y[3];
+        ExpandBezierCoefficients(params_, x);
+        ExpandBezierCoefficients(params_ + 2, y);
+        if (progress <= 0.0f || progress >= 1.0f) {
+            // Follow the tangent at the end point, the slope of the curve there is c_y / c_x,
+            // degenerating to the chord to the other control point, as CSS does
+            // Only a bezier gets here, the linear default just keeps -Wmaybe-uninitialized quiet
+            float points[4] = {0.0f, 0.0f, 1.0f, 1.0f};
+            GetControlPoints(points);
+            float slope = 0.0f;
+            if (progress <= 0.0f) {
+                if (points[0] > 0.0f) slope = points[1] / points[0];
+                else if (points[2] > 0.0f) slope = points[3] / points[2];
+                return slope * progress;
+            }
+            if (points[2] < 1.0f) slope = (points[3] - 1.0f) / (points[2] - 1.0f);
+            else if (points[0] < 1.0f) slope = (points[1] - 1.0f) / (points[0] - 1.0f);
+            return 1.0f + slope * (progress - 1.0f);
+        }
+
+        static const int kNewtonIterations = 8;
+        // Solving to float precision of t, the error in x can't go much below that of progress
+        static const float kEpsilon = 1e-7f;
+        float t = bezier_samples_ ? bezier_samples_->Guess(progress) : progress;
+        for (int i = 0; i < kNewtonIterations; ++i) {
+            const float error = BezierSample(x, t) - progress;
+            if (std::fabs(error) <= kEpsilon) return BezierSample(y, t);
+            const float slope = BezierSlope(x, t);
+            // Flat spot, Newton's method would diverge
+            if (std::fabs(slope) < 1e-6f) break;
+            const float step = error / slope;
+            t = std::min(std::max(t - step, 0.0f), 1.0f);
+            if (std::fabs(step) <= kEpsilon) return BezierSample(y, t);
+        }
+
+        // x(t) is increasing on [0, 1], halve the bracket until the float resolution of t
+        float low = 0.0f;
+        float high = 1.0f;
+        t = progress;
+        for (int i = 0; i < 32; ++i) {
+            const float error = BezierSample(x, t) - progress;
+            if (std::fabs(error) <= kEpsilon) break;
+            if (error < 0.0f) low = t;
+            else high = t;
+            t = 0.5f * (low + high);
+        }
+        return BezierSample(y, t);
+    }
+
+    struct BakedCurveTable
+    {
+        int resolution;
+        float max_error;
+        std::vector<float> samples;
+        // What the curve held before it was baked, see EasingCurve::Unbake()
+        CurveFunction func;
+        const BezierSampleTable *bezier_samples;
+
+        float ValueForProgress(float progress) const {
+            progress = std::min(std::max(progress, 0.0f), 1.0f);
+            const float x = progress * float(resolution);
+            const int i = std::min(int(x), resolution - 1);
+            const float f = x - float(i);
+            return samples[i] + (samples[i + 1] - samples[i]) * f;
+        }
+    };
+
+    using CurveParameterArray = std::array<float, 4>;
+
+    static const BakedCurveTable *GetBakedTable(const EasingCurve &curve, CurveFunction func,
+                                                const BezierSampleTable *bezier_samples,
+                                                const CurveParameterArray &params, int resolution)
+    {
+        // Tables are never released, curves keep plain pointers to them
+        using Key = std::tuple<CurveType, CurveFunction, CurveParameterArray, int>;
+        static std::mutex mutex;
+        static std::map<Key, std::unique_ptr<BakedCurveTable>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<BakedCurveTable> &table = tables[Key(curve.type(), func, params, resolution)];
+        if (table) return table.get();
+
+        table.reset(new BakedCurveTable{resolution, 0.0f, std::vector<float>(resolution + 1), func, bezier_samples});
+        for (int i = 0; i <= resolution; ++i) {
+            table->samples[i] = curve.ValueForProgress(float(i) / float(resolution));
+        }
+        // Measure between the samples, where the interpolation is furthest from the curve
+        static const int kErrorSubsamples = 16;
+        const int count = resolution * kErrorSubsamples;
+        for (int i = 0; i <= count; ++i) {
+            const float progress = float(i) / float(count);
+            const float error = std::fabs(table->ValueForProgress(progress) - curve.ValueForProgress(progress));
+            table->max_error = std::max(table->max_error, error);
+        }
+        return table.get();
+    }
+
+    void EasingCurve::Unbake() {
+        if (CurveType::Custom == type()) func_ = table_->func;
+        else bezier_samples_ = table_->bezier_samples;
+        flags_ &= ~kBaked;
+    }
+
+    EasingCurve EasingCurve::Baked(int resolution) const {
+        EasingCurve source = *this;
+        if (source.IsBaked()) source.Unbake();
+        CurveParameterArray params;
+        std::copy(params_, params_ + params.size(), params.begin());
+        // Built-in curves are told apart by their type, Custom ones by their function
+        const bool custom = CurveType::Custom == type();
+        EasingCurve baked = source;
+        baked.table_ = GetBakedTable(source, custom ? source.func_ : nullptr,
+                                     custom ? nullptr : source.bezier_samples_, params,
+                                     std::min(std::max(resolution, 2), 65536));
+        baked.flags_ |= kBaked;
+        return baked;
+    }
+
+    float EasingCurve::baked_max_error() const {
+        return IsBaked() ? table_->max_error : 0.0f;
+    }
 
     float EasingCurve::ValueForProgress(float progress) const { 
-        return func_ ? func_(progress) : progress;
+        if (IsBaked()) return table_->ValueForProgress(progress);
+        const CurveType type = this->type();
+        if (IsParameterized(type)) {
+            return ParameterizedValue(type, progress, CurveParameters{params_[0], params_[1], params_[2]});
+        }
+        if (CurveType::CubicBezier == type) return BezierValueForProgress(progress);
+        const CurveFunction func = CurveType::Custom == type ? func_ : CurveToKernels(type).func;
+        return func ? func(progress) : progress;
+    }
+
+    void EasingCurve::ValuesForProgress(const float *progress, float *values, size_t count) const {
+        if (IsBaked()) {
+            for (size_t i = 0; i < count; ++i) {
+                values[i] = table_->ValueForProgress(progress[i]);
+            }
+            return;
+        }
+        const CurveType type = this->type();
+        if (CurveType::CubicBezier == type) {
+            for (size_t i = 0; i < count; ++i) {
+                values[i] = BezierValueForProgress(progress[i]);
+            }
+            return;
+        }
+        if (CurveType::Custom != type) {
+            const simd::ArrayKernel kernel = simd::GetArrayKernel(simd_level(), type);
+            (kernel ? kernel : CurveToKernels(type).array_func)(progress, values, count,
+                                                                CurveParameters{params_[0], params_[1], params_[2]});
+            return;
+        }
+        if (nullptr == func_) {
+            std::copy(progress, progress + count, values);
+            return;
+        }
+        const CurveFunction func = func_;
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = func(progress[i]);
+        }
+    }
+
+    constexpr float EasingCurve::kSimdMaxError;
+
+    static std::atomic<SimdLevel> &CurrentSimdLevel()
+    {
+        static std::atomic<SimdLevel> level(simd::DetectLevel());
+        return level;
+    }
+
+    SimdLevel EasingCurve::simd_level() {
+        return CurrentSimdLevel().load(std::memory_order_relaxed);
+    }
+
+    bool EasingCurve::SetSimdLevel(SimdLevel level) {
+        if (!simd::IsSupported(level)) return false;
+        CurrentSimdLevel().store(level, std::memory_order_relaxed);
+        return true;
     }
 }
@@ -0,0 +1,83 @@
+/*
+ * Layout of the files read by ClipFile and written by ClipWriter, version 2.
+ *
+ * A header, a directory of clips sorted by name, a hash table of the names, then the names and
+ * the arrays of every clip. Offsets are from the start of the file, arrays start on 16 byte
+ * boundaries.
+ */
+#pragma once
+#include <cstdint>
+
+#include "cc_easing_curve.hpp"
+
+namespace anim
+{
+    namespace clip_format
+    {
+        const char kMagic[4] = {'C', 'C', 'A', 'C'};
+        // Reads back as another value on a machine of the other byte order
+        const uint32_t kByteOrderMark = 0x01020304u;
+        const uint64_t kArrayAlignment = 16;
+
+        struct Header
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t byte_order;
+            uint32_t clip_count;
+            uint64_t file_size;
+            uint64_t directory_offset;
+            // name_slot_count NameSlot, a power of 2 larger than clip_count
+            uint64_t name_slots_offset;
+            uint32_t name_slot_count;
+            uint32_t reserved;
+        };
+
+        // Open addressing with linear probing, from the slot HashName(name) & (name_slot_count - 1)
+        struct NameSlot
+        {
+            uint32_t hash;
+            // The index of the clip in the directory, kNoClip for an empty slot
+            uint32_t clip;
+        };
+
+        const uint32_t kNoClip = 0xffffffffu;
+
+        // 32 bit FNV-1a of a NUL terminated name
+        inline uint32_t HashName(const char *name) {
+            uint32_t hash = 2166136261u;
+            for (; '\0' != *name; ++name) {
+                hash = (hash ^ uint8_t(*name)) * 16777619u;
+            }
+            return hash;
+        }
+
+        struct ClipRecord
+        {
+            // A NUL terminated name of name_size characters
+            uint64_t name_offset;
+            uint32_t name_size;
+            uint32_t value_type;
+            uint32_t value_size;
+            uint32_t keyframe_count;
+            uint32_t bucket_count;
+            float bucket_start;
+            float bucket_scale;
+            uint32_t reserved;
+            int64_t duration_ns;
+            // keyframe_count floats
+            uint64_t progress_offset;
+            // keyframe_count values of value_size bytes
+            uint64_t values_offset;
+            // keyframe_count - 1 CurveRecord, 0 when every segment is linear
+            uint64_t curves_offset;
+            // bucket_count uint32_t
+            uint64_t buckets_offset;
+        };
+
+        static_assert(sizeof(Header) == 48, "The header layout is part of the format");
+        static_assert(sizeof(NameSlot) == 8, "The name table layout is part of the format");
+        static_assert(sizeof(ClipRecord) == 80, "The directory layout is part of the format");
+        static_assert(sizeof(CurveRecord) == 28, "The curve layout is part of the format");
+    } // namespace clip_format
+} // namespace anim
@@ -0,0 +1,75 @@
+/*
+ * Multi-producer single-consumer queue of the commands posted to an AnimationDriver.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+namespace anim
+{
+    /**
+     * @brief Unbounded MPSC queue, a linked list of nodes with a dummy head.
+     *
+     * Push() is wait-free apart from allocating its node: one exchange and one store. Pop() is
+     * only called by the consumer. A push caught between its two steps hides the items pushed
+     * after it until it completes, Pop() then reports the queue empty and they are picked up later.
+     */
+    template <typename T>
+    class CommandQueue
+    {
+    public:
+        CommandQueue() : head_(new Node()), tail_(head_.load(std::memory_order_relaxed)) {}
+        CommandQueue(const CommandQueue &) = delete;
+        CommandQueue &operator=(const CommandQueue &) = delete;
+        ~CommandQueue() {
+            while (tail_) {
+                Node *next = tail_->next.load(std::memory_order_relaxed);
+                delete tail_;
+                tail_ = next;
+            }
+        }
+
+        // Any thread
+        void Push(const T &value) {
+            Node *node = new Node(value);
+            Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // Consumer only
+        bool Pop(T *value) {
+            Node *next = tail_->next.load(std::memory_order_acquire);
+            if (nullptr == next) return false;
+            *value = next->value;
+            delete tail_;
+            // next becomes the dummy
+            tail_ = next;
+            return true;
+        }
+
+        // Consumer only, a hint which may miss pushes in progress
+        bool IsEmpty() const { return nullptr == tail_->next.load(std::memory_order_acquire); }
+
+    private:
+        struct Node
+        {
+            Node() = default;
+            explicit Node(const T &v) : value(v) {}
+            std::atomic<Node *> next{nullptr};
+            T value{};
+        };
+
+        static const size_t kCacheLineSize = 64;
+        static const size_t kPadding = kCacheLineSize - sizeof(Node *);
+
+        // The padding keeps head_ and tail_ on lines of their own whatever the alignment the
+        // queue gets, unlike alignas(64), which C++14 new ignores
+        char leading_padding_[kPadding];
+        // Last pushed node, written by the producers
+        std::atomic<Node *> head_;
+        char head_padding_[kPadding];
+        // Dummy node before the first item, owned by the consumer
+        Node *tail_;
+        char tail_padding_[kPadding];
+    };
+} // namespace anim
@@ -13,6 +13,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 #include <algorithm>
 #include <cmath>
+#include "cc_easing_equations.hpp"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -23,111 +24,16 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 namespace anim
 {
 using real = float;
-/**
- * Easing equation function for a simple linear tweening, with no easing.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeNone(real progress)
-{
-    return progress;
-}
-/**
- * Easing equation function for a quadratic (t^2) easing in: accelerating from zero velocity.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeInQuad(real t)
-{
-    return t*t;
-}
-/**
-* Easing equation function for a quadratic (t^2) easing out: decelerating to zero velocity.
-*
-* @param t		Current time (in frames or seconds).
-* @return		The correct value.
-*/
-static real easeOutQuad(real t)
-{
-    return -t*(t-2);
-}
-/**
- * Easing equation function for a quadratic (t^2) easing in/out: acceleration until halfway, then deceleration.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeInOutQuad(real t)
-{
-    t*=2.0;
-    if (t < 1) {
-        return t*t/real(2);
-    } else {
-        --t;
-        return -0.5 * (t*(t-2) - 1);
-    }
-}
-/**
- * Easing equation function for a quadratic (t^2) easing out/in: deceleration until halfway, then acceleration.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeOutInQuad(real t)
-{
-    if (t < 0.5) return easeOutQuad (t*2)/2;
-    return easeInQuad((2*t)-1)/2 + 0.5;
-}
-/**
- * Easing equation function for a cubic (t^3) easing in: accelerating from zero velocity.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeInCubic(real t)
-{
-    return t*t*t;
-}
-/**
- * Easing equation function for a cubic (t^3) easing out: decelerating to zero velocity.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeOutCubic(real t)
-{
-    t-=1.0;
-    return t*t*t + 1;
-}
-/**
- * Easing equation function for a cubic (t^3) easing in/out: acceleration until halfway, then deceleration.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeInOutCubic(real t)
-{
-    t*=2.0;
-    if(t < 1) {
-        return 0.5*t*t*t;
-    } else {
-        t -= real(2.0);
-        return 0.5*(t*t*t + 2);
-    }
-}
-/**
- * Easing equation function for a cubic (t^3) easing out/in: deceleration until halfway, then acceleration.
- *
- * @param t		Current time (in frames or seconds).
- * @return		The correct value.
- */
-static real easeOutInCubic(real t)
-{
-    if (t < 0.5) return easeOutCubic (2*t)/2;
-    return easeInCubic(2*t - 1)/2 + 0.5;
-}
+// Linear, Quad and Cubic, in cc_easing_equations.hpp
+using easing::easeNone;
+using easing::easeInQuad;
+using easing::easeOutQuad;
+using easing::easeInOutQuad;
+using easing::easeOutInQuad;
+using easing::easeInCubic;
+using easing::easeOutCubic;
+using easing::easeInOutCubic;
+using easing::easeOutInCubic;
 /**
  * Easing equation function for a quartic (t^4) easing in: accelerating from zero velocity.
  *
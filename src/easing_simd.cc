@@ -0,0 +1,170 @@
+/*
+ * SSE2 and NEON backends of the vectorized easing kernels, and the runtime selection between
+ * them, the AVX2 backend (easing_simd_avx2.cc) and the scalar code.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_ANIMATION_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define CC_ANIMATION_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include <initializer_list>
+
+#include "easing_vector.h"
+
+namespace anim
+{
+namespace simd
+{
+namespace
+{
+#if CC_ANIMATION_HAS_SSE2
+    struct Sse2
+    {
+        using F = __m128;
+        using I = __m128i;
+        using M = __m128;
+        static const size_t kWidth = 4;
+
+        static F Load(const float *p) { return _mm_loadu_ps(p); }
+        static void Store(float *p, F v) { _mm_storeu_ps(p, v); }
+        static F Set(float x) { return _mm_set1_ps(x); }
+        static F Add(F a, F b) { return _mm_add_ps(a, b); }
+        static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+        static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+        static F Div(F a, F b) { return _mm_div_ps(a, b); }
+        static F Min(F a, F b) { return _mm_min_ps(a, b); }
+        static F Max(F a, F b) { return _mm_max_ps(a, b); }
+        static F Sqrt(F a) { return _mm_sqrt_ps(a); }
+        static M Less(F a, F b) { return _mm_cmplt_ps(a, b); }
+        static M Equal(F a, F b) { return _mm_cmpeq_ps(a, b); }
+        static M And(M a, M b) { return _mm_and_ps(a, b); }
+        static M Or(M a, M b) { return _mm_or_ps(a, b); }
+        static F Select(M mask, F a, F b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        static I Round(F a) { return _mm_cvtps_epi32(a); }
+        static F ToFloat(I a) { return _mm_cvtepi32_ps(a); }
+        static I SetI(int x) { return _mm_set1_epi32(x); }
+        static I AddI(I a, I b) { return _mm_add_epi32(a, b); }
+        static M TestI(I a, I bits) {
+            const I masked = _mm_and_si128(a, bits);
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(masked, bits));
+        }
+        static F Pow2I(I n) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23)); }
+    };
+#endif
+
+#if CC_ANIMATION_HAS_NEON
+    struct Neon
+    {
+        using F = float32x4_t;
+        using I = int32x4_t;
+        using M = uint32x4_t;
+        static const size_t kWidth = 4;
+
+        static F Load(const float *p) { return vld1q_f32(p); }
+        static void Store(float *p, F v) { vst1q_f32(p, v); }
+        static F Set(float x) { return vdupq_n_f32(x); }
+        static F Add(F a, F b) { return vaddq_f32(a, b); }
+        static F Sub(F a, F b) { return vsubq_f32(a, b); }
+        static F Mul(F a, F b) { return vmulq_f32(a, b); }
+        static F Div(F a, F b) { return vdivq_f32(a, b); }
+        static F Min(F a, F b) { return vminq_f32(a, b); }
+        static F Max(F a, F b) { return vmaxq_f32(a, b); }
+        static F Sqrt(F a) { return vsqrtq_f32(a); }
+        static M Less(F a, F b) { return vcltq_f32(a, b); }
+        static M Equal(F a, F b) { return vceqq_f32(a, b); }
+        static M And(M a, M b) { return vandq_u32(a, b); }
+        static M Or(M a, M b) { return vorrq_u32(a, b); }
+        static F Select(M mask, F a, F b) { return vbslq_f32(mask, a, b); }
+        static I Round(F a) { return vcvtnq_s32_f32(a); }
+        static F ToFloat(I a) { return vcvtq_f32_s32(a); }
+        static I SetI(int x) { return vdupq_n_s32(x); }
+        static I AddI(I a, I b) { return vaddq_s32(a, b); }
+        static M TestI(I a, I bits) { return vceqq_s32(vandq_s32(a, bits), bits); }
+        static F Pow2I(I n) { return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(127)), 23)); }
+    };
+#endif
+
+    struct KernelTable
+    {
+        ArrayKernel kernels[kCurveTypeCount] = {};
+        bool available = false;
+    };
+
+    template <class B>
+    KernelTable MakeTable()
+    {
+        KernelTable table;
+        GetKernels<B>(table.kernels);
+        table.available = true;
+        return table;
+    }
+
+    bool CpuHasAvx2()
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4];
+        __cpuid(info, 1);
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        return fma && os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }
+    KernelTable MakeAvx2Table()
+    {
+        // easing_simd_avx2.cc may use AVX instructions anywhere, only call into it on CPUs that have them
+        KernelTable table;
+        table.available = CpuHasAvx2() && GetAvx2Kernels(table.kernels);
+        return table;
+    }
+
+    const KernelTable &GetTable(SimdLevel level)
+    {
+        static const KernelTable none;
+#if CC_ANIMATION_HAS_SSE2
+        static const KernelTable sse2 = MakeTable<Sse2>();
+        static const KernelTable avx2 = MakeAvx2Table();
+        if (SimdLevel::kSse2 == level) return sse2;
+        if (SimdLevel::kAvx2 == level) return avx2;
+#endif
+#if CC_ANIMATION_HAS_NEON
+        static const KernelTable neon = MakeTable<Neon>();
+        if (SimdLevel::kNeon == level) return neon;
+#endif
+        return none;
+    }
+
+} // namespace
+
+    bool IsSupported(SimdLevel level)
+    {
+        return SimdLevel::kScalar == level || GetTable(level).available;
+    }
+
+    SimdLevel DetectLevel()
+    {
+        for (SimdLevel level : {SimdLevel::kAvx2, SimdLevel::kSse2, SimdLevel::kNeon}) {
+            if (IsSupported(level)) return level;
+        }
+        return SimdLevel::kScalar;
+    }
+
+    ArrayKernel GetArrayKernel(SimdLevel level, CurveType type)
+    {
+        if (SimdLevel::kScalar == level || int(type) >= kCurveTypeCount) return nullptr;
+        return GetTable(level).kernels[int(type)];
+    }
+} // namespace simd
+} // namespace anim
@@ -0,0 +1,43 @@
+/*
+ * Runtime dispatch of the vectorized easing kernels in easing_vector.h.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "cc_easing_curve.hpp"
+
+namespace anim
+{
+namespace simd
+{
+    /**
+     * @brief The parameters of the Elastic, Back and Bounce curves, the other curves ignore them.
+     */
+    struct CurveParameters
+    {
+        float amplitude;
+        float period;
+        float overshoot;
+    };
+
+    using ArrayKernel = void (*)(const float *, float *, size_t, const CurveParameters &);
+
+    /**
+     * @brief The best level supported by both the build and the CPU we are running on.
+     */
+    SimdLevel DetectLevel();
+    bool IsSupported(SimdLevel level);
+
+    /**
+     * @brief The kernel of the curve for the given level, nullptr if it has no vectorized version.
+     */
+    ArrayKernel GetArrayKernel(SimdLevel level, CurveType type);
+
+    /**
+     * @brief Defined in easing_simd_avx2.cc, which is the only file built with AVX2 enabled.
+     * @return false if the library was built without AVX2 support.
+     */
+    bool GetAvx2Kernels(ArrayKernel *kernels);
+} // namespace simd
+} // namespace anim
@@ -0,0 +1,61 @@
+/*
+ * AVX2 backend of the vectorized easing kernels. This is the only file built with AVX2 enabled
+ * (see src/CMakeLists.txt), easing_simd.cc only calls into it after checking the CPU.
+ */
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "easing_vector.h"
+
+namespace anim
+{
+namespace simd
+{
+#if defined(__AVX2__)
+namespace
+{
+    struct Avx2
+    {
+        using F = __m256;
+        using I = __m256i;
+        using M = __m256;
+        static const size_t kWidth = 8;
+
+        static F Load(const float *p) { return _mm256_loadu_ps(p); }
+        static void Store(float *p, F v) { _mm256_storeu_ps(p, v); }
+        static F Set(float x) { return _mm256_set1_ps(x); }
+        static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+        static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+        static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+        static F Div(F a, F b) { return _mm256_div_ps(a, b); }
+        static F Min(F a, F b) { return _mm256_min_ps(a, b); }
+        static F Max(F a, F b) { return _mm256_max_ps(a, b); }
+        static F Sqrt(F a) { return _mm256_sqrt_ps(a); }
+        static M Less(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static M Equal(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        static M And(M a, M b) { return _mm256_and_ps(a, b); }
+        static M Or(M a, M b) { return _mm256_or_ps(a, b); }
+        static F Select(M mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+        static I Round(F a) { return _mm256_cvtps_epi32(a); }
+        static F ToFloat(I a) { return _mm256_cvtepi32_ps(a); }
+        static I SetI(int x) { return _mm256_set1_epi32(x); }
+        static I AddI(I a, I b) { return _mm256_add_epi32(a, b); }
+        static M TestI(I a, I bits) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, bits), bits)); }
+        static F Pow2I(I n) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23)); }
+    };
+} // namespace
+
+    bool GetAvx2Kernels(ArrayKernel *kernels)
+    {
+        GetKernels<Avx2>(kernels);
+        return true;
+    }
+#else
+    bool GetAvx2Kernels(ArrayKernel *)
+    {
+        return false;
+    }
+#endif
+} // namespace simd
+} // namespace anim
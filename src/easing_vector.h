@@ -0,0 +1,437 @@
+/*
+ * Vectorized versions of the Penner curves in easing.cc.
+ *
+ * The kernels are written once against a backend B which wraps one instruction set (see
+ * easing_simd.cc and easing_simd_avx2.cc). A backend provides the native float, int and mask
+ * vector types F, I and M, the lane count kWidth and a handful of static operations on them.
+ * Every template here is parameterized on a backend defined in an anonymous namespace and
+ * everything else is in an anonymous namespace too, so including this header from translation
+ * units built with different target flags can not produce ODR clashes between them: the linker
+ * must never pick an AVX2 copy of a function for the SSE2 path. For the same reason nothing here
+ * calls the inline float overloads of <cmath>, only the double ones exported by libm.
+ *
+ * Branches of the scalar code are evaluated on both sides and blended with Select(), and the
+ * transcendental functions are float polynomials instead of the double std:: versions, so the
+ * results are not bit-identical to easing.cc; see EasingCurve::kSimdMaxError for the bound.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "cc_easing_curve.hpp"
+#include "easing_simd.h"
+
+namespace anim
+{
+namespace simd
+{
+    template <class B>
+    struct VMask
+    {
+        typename B::M v;
+        VMask(typename B::M m) : v(m) {}
+        friend VMask operator&(VMask a, VMask b) { return B::And(a.v, b.v); }
+        friend VMask operator|(VMask a, VMask b) { return B::Or(a.v, b.v); }
+    };
+
+    template <class B>
+    struct VFloat
+    {
+        typename B::F v;
+        VFloat(typename B::F x) : v(x) {}
+        VFloat(float x) : v(B::Set(x)) {}
+
+        friend VFloat operator+(VFloat a, VFloat b) { return B::Add(a.v, b.v); }
+        friend VFloat operator-(VFloat a, VFloat b) { return B::Sub(a.v, b.v); }
+        friend VFloat operator*(VFloat a, VFloat b) { return B::Mul(a.v, b.v); }
+        friend VFloat operator/(VFloat a, VFloat b) { return B::Div(a.v, b.v); }
+        friend VFloat operator-(VFloat a) { return B::Sub(B::Set(0.0f), a.v); }
+        friend VMask<B> operator<(VFloat a, VFloat b) { return B::Less(a.v, b.v); }
+        friend VMask<B> operator==(VFloat a, VFloat b) { return B::Equal(a.v, b.v); }
+        VFloat &operator*=(VFloat b) { v = B::Mul(v, b.v); return *this; }
+        VFloat &operator-=(VFloat b) { v = B::Sub(v, b.v); return *this; }
+    };
+
+    template <class B> inline VFloat<B> Select(VMask<B> mask, VFloat<B> a, VFloat<B> b) { return B::Select(mask.v, a.v, b.v); }
+    template <class B> inline VFloat<B> Min(VFloat<B> a, VFloat<B> b) { return B::Min(a.v, b.v); }
+    template <class B> inline VFloat<B> Max(VFloat<B> a, VFloat<B> b) { return B::Max(a.v, b.v); }
+    template <class B> inline VFloat<B> Sqrt(VFloat<B> a) { return B::Sqrt(a.v); }
+
+    // sin(pi * x) for quadrant offset 0, cos(pi * x) for offset 1. The reduction happens on x
+    // before the multiplication by pi, where subtracting the multiple of 1/2 is exact.
+    template <class B>
+    inline VFloat<B> SinCosPi(VFloat<B> x, int quadrant_offset)
+    {
+        using F = VFloat<B>;
+        const typename B::I j = B::Round((x * F(2.0f)).v);
+        const F r = (x - F(B::ToFloat(j)) * F(0.5f)) * F(3.14159265358979323846f);
+        const F z = r * r;
+        const F sin_r = r + r * z * (F(-1.6666654611e-1f) + z * (F(8.3321608736e-3f) + z * F(-1.9515295891e-4f)));
+        const F cos_r = F(1.0f) - F(0.5f) * z + z * z * (F(4.166664568298827e-2f) + z * (F(-1.388731625493765e-3f) + z * F(2.443315711809948e-5f)));
+        const typename B::I q = B::AddI(j, B::SetI(quadrant_offset));
+        const VMask<B> use_cos = B::TestI(q, B::SetI(1));
+        const VMask<B> negate = B::TestI(q, B::SetI(2));
+        const F value = Select(use_cos, cos_r, sin_r);
+        return Select(negate, -value, value);
+    }
+
+    template <class B> inline VFloat<B> SinPi(VFloat<B> x) { return SinCosPi(x, 0); }
+    template <class B> inline VFloat<B> CosPi(VFloat<B> x) { return SinCosPi(x, 1); }
+
+    // 2^x, as an integer power of two scaled by a polynomial for the fraction in [-0.5, 0.5]
+    template <class B>
+    inline VFloat<B> Exp2(VFloat<B> x)
+    {
+        using F = VFloat<B>;
+        x = Min(Max(x, F(-126.0f)), F(126.0f));
+        const typename B::I n = B::Round(x.v);
+        const F f = x - F(B::ToFloat(n));
+        const F p = F(1.0f) + f * (F(6.931472028550421e-1f) + f * (F(2.402264791363012e-1f) + f * (F(5.550332471162809e-2f)
+                    + f * (F(9.618437357674640e-3f) + f * (F(1.339887440266574e-3f) + f * F(1.535336188319500e-4f))))));
+        return p * F(B::Pow2I(n));
+    }
+
+    template <class B> inline VFloat<B> easeNone(VFloat<B> t) { return t; }
+
+    template <class B> inline VFloat<B> easeInQuad(VFloat<B> t) { return t * t; }
+    template <class B> inline VFloat<B> easeOutQuad(VFloat<B> t) { return -t * (t - 2.0f); }
+    template <class B> inline VFloat<B> easeInOutQuad(VFloat<B> t)
+    {
+        t *= 2.0f;
+        const VFloat<B> u = t - 1.0f;
+        return Select(t < 1.0f, t * t * 0.5f, -0.5f * (u * (u - 2.0f) - 1.0f));
+    }
+    template <class B> inline VFloat<B> easeOutInQuad(VFloat<B> t)
+    {
+        return Select(t < 0.5f, easeOutQuad(t * 2.0f) * 0.5f, easeInQuad(t * 2.0f - 1.0f) * 0.5f + 0.5f);
+    }
+
+    template <class B> inline VFloat<B> easeInCubic(VFloat<B> t) { return t * t * t; }
+    template <class B> inline VFloat<B> easeOutCubic(VFloat<B> t)
+    {
+        t -= 1.0f;
+        return t * t * t + 1.0f;
+    }
+    template <class B> inline VFloat<B> easeInOutCubic(VFloat<B> t)
+    {
+        t *= 2.0f;
+        const VFloat<B> u = t - 2.0f;
+        return Select(t < 1.0f, 0.5f * t * t * t, 0.5f * (u * u * u + 2.0f));
+    }
+    template <class B> inline VFloat<B> easeOutInCubic(VFloat<B> t)
+    {
+        return Select(t < 0.5f, easeOutCubic(t * 2.0f) * 0.5f, easeInCubic(t * 2.0f - 1.0f) * 0.5f + 0.5f);
+    }
+
+    template <class B> inline VFloat<B> easeInQuart(VFloat<B> t) { return t * t * t * t; }
+    template <class B> inline VFloat<B> easeOutQuart(VFloat<B> t)
+    {
+        t -= 1.0f;
+        return -(t * t * t * t - 1.0f);
+    }
+    template <class B> inline VFloat<B> easeInOutQuart(VFloat<B> t)
+    {
+        t *= 2.0f;
+        const VFloat<B> u = t - 2.0f;
+        return Select(t < 1.0f, 0.5f * t * t * t * t, -0.5f * (u * u * u * u - 2.0f));
+    }
+    template <class B> inline VFloat<B> easeOutInQuart(VFloat<B> t)
+    {
+        return Select(t < 0.5f, easeOutQuart(t * 2.0f) * 0.5f, easeInQuart(t * 2.0f - 1.0f) * 0.5f + 0.5f);
+    }
+
+    template <class B> inline VFloat<B> easeInQuint(VFloat<B> t) { return t * t * t * t * t; }
+    template <class B> inline VFloat<B> easeOutQuint(VFloat<B> t)
+    {
+        t -= 1.0f;
+        return t * t * t * t * t + 1.0f;
+    }
+    template <class B> inline VFloat<B> easeInOutQuint(VFloat<B> t)
+    {
+        t *= 2.0f;
+        const VFloat<B> u = t - 2.0f;
+        return Select(t < 1.0f, 0.5f * t * t * t * t * t, 0.5f * (u * u * u * u * u + 2.0f));
+    }
+    template <class B> inline VFloat<B> easeOutInQuint(VFloat<B> t)
+    {
+        return Select(t < 0.5f, easeOutQuint(t * 2.0f) * 0.5f, easeInQuint(t * 2.0f - 1.0f) * 0.5f + 0.5f);
+    }
+
+    template <class B> inline VFloat<B> easeInSine(VFloat<B> t)
+    {
+        return Select(t == 1.0f, VFloat<B>(1.0f), 1.0f - CosPi(t * 0.5f));
+    }
+    template <class B> inline VFloat<B> easeOutSine(VFloat<B> t) { return SinPi(t * 0.5f); }
+    template <class B> inline VFloat<B> easeInOutSine(VFloat<B> t) { return -0.5f * (CosPi(t) - 1.0f); }
+    template <class B> inline VFloat<B> easeOutInSine(VFloat<B> t)
+    {
+        return Select(t < 0.5f, easeOutSine(t * 2.0f) * 0.5f, easeInSine(t * 2.0f - 1.0f) * 0.5f + 0.5f);
+    }
+
+    template <class B> inline VFloat<B> easeInExpo(VFloat<B> t)
+    {
+        return Select((t == 0.0f) | (t == 1.0f), t, Exp2(10.0f * (t - 1.0f)) - 0.001f);
+    }
+    template <class B> inline VFloat<B> easeOutExpo(VFloat<B> t)
+    {
+        return Select(t == 1.0f, VFloat<B>(1.0f), 1.001f * (1.0f - Exp2(-10.0f * t)));
+    }
+    template <class B> inline VFloat<B> easeInOutExpo(VFloat<B> t)
+    {
+        using F = VFloat<B>;
+        const F s = t * 2.0f;
+        const F value = Select(s < 1.0f, 0.5f * Exp2(10.0f * (s - 1.0f)) - 0.0005f,
+                               0.5f * 1.0005f * (2.0f - Exp2(-10.0f * (s - 1.0f))));
+        return Select(t == 0.0f, F(0.0f), Select(t == 1.0f, F(1.0f), value));
+    }
+    template <class B> inline VFloat<B> easeOutInExpo(VFloat<B> t)
+    {
+        return Select(t < 0.5f, easeOutExpo(t * 2.0f) * 0.5f, easeInExpo(t * 2.0f - 1.0f) * 0.5f + 0.5f);
+    }
+
+    template <class B> inline VFloat<B> easeInCirc(VFloat<B> t) { return -(Sqrt(1.0f - t * t) - 1.0f); }
+    template <class B> inline VFloat<B> easeOutCirc(VFloat<B> t)
+    {
+        t -= 1.0f;
+        return Sqrt(1.0f - t * t);
+    }
+    template <class B> inline VFloat<B> easeInOutCirc(VFloat<B> t)
+    {
+        t *= 2.0f;
+        const VFloat<B> u = t - 2.0f;
+        return Select(t < 1.0f, -0.5f * (Sqrt(1.0f - t * t) - 1.0f), 0.5f * (Sqrt(1.0f - u * u) + 1.0f));
+    }
+    template <class B> inline VFloat<B> easeOutInCirc(VFloat<B> t)
+    {
+        return Select(t < 0.5f, easeOutCirc(t * 2.0f) * 0.5f, easeInCirc(t * 2.0f - 1.0f) * 0.5f + 0.5f);
+    }
+
+namespace
+{
+    /**
+     * @brief CurveParameters plus what the Elastic curves derive from them, computed once per array.
+     */
+    struct KernelParameters
+    {
+        float amplitude;
+        float period;
+        float overshoot;
+        // Amplitude and phase shift of easeInElastic_helper()/easeOutElastic_helper() for a change
+        // of 1 (index 0) and of 0.5 (index 1)
+        float elastic_amplitude[2];
+        float elastic_shift[2];
+
+        explicit KernelParameters(const CurveParameters &params)
+            : amplitude(params.amplitude), period(params.period), overshoot(params.overshoot)
+        {
+            const float changes[2] = {1.0f, 0.5f};
+            for (int i = 0; i < 2; ++i) {
+                if (amplitude < changes[i]) {
+                    elastic_amplitude[i] = changes[i];
+                    elastic_shift[i] = period / 4.0f;
+                } else {
+                    elastic_amplitude[i] = amplitude;
+                    elastic_shift[i] = float(period / (2 * 3.14159265358979323846) * std::asin(double(changes[i] / amplitude)));
+                }
+            }
+        }
+    };
+} // namespace
+
+    template <class B>
+    inline VFloat<B> easeInElastic_helper(VFloat<B> t, float b, float c, float a, float s, float p)
+    {
+        const VFloat<B> u = t - 1.0f;
+        const VFloat<B> value = -(a * Exp2(10.0f * u) * SinPi((u - s) * (2.0f / p))) + b;
+        return Select(t == 0.0f, VFloat<B>(b), Select(t == 1.0f, VFloat<B>(b + c), value));
+    }
+    template <class B>
+    inline VFloat<B> easeOutElastic_helper(VFloat<B> t, float c, float a, float s, float p)
+    {
+        const VFloat<B> value = a * Exp2(-10.0f * t) * SinPi((t - s) * (2.0f / p)) + c;
+        return Select(t == 0.0f, VFloat<B>(0.0f), Select(t == 1.0f, VFloat<B>(c), value));
+    }
+    template <class B> inline VFloat<B> easeInElastic(VFloat<B> t, const KernelParameters &k)
+    {
+        return easeInElastic_helper(t, 0.0f, 1.0f, k.elastic_amplitude[0], k.elastic_shift[0], k.period);
+    }
+    template <class B> inline VFloat<B> easeOutElastic(VFloat<B> t, const KernelParameters &k)
+    {
+        return easeOutElastic_helper(t, 1.0f, k.elastic_amplitude[0], k.elastic_shift[0], k.period);
+    }
+    template <class B> inline VFloat<B> easeInOutElastic(VFloat<B> t, const KernelParameters &k)
+    {
+        using F = VFloat<B>;
+        const float a = k.elastic_amplitude[0];
+        const float s = k.elastic_shift[0];
+        const F u = t * 2.0f - 1.0f;
+        const F wave = a * SinPi((u - s) * (2.0f / k.period));
+        const F value = Select(u < 0.0f, -0.5f * (wave * Exp2(10.0f * u)), wave * Exp2(-10.0f * u) * 0.5f + 1.0f);
+        return Select(t == 0.0f, F(0.0f), Select(u == 1.0f, F(1.0f), value));
+    }
+    template <class B> inline VFloat<B> easeOutInElastic(VFloat<B> t, const KernelParameters &k)
+    {
+        const float a = k.elastic_amplitude[1];
+        const float s = k.elastic_shift[1];
+        return Select(t < 0.5f, easeOutElastic_helper(t * 2.0f, 0.5f, a, s, k.period),
+                      easeInElastic_helper(t * 2.0f - 1.0f, 0.5f, 0.5f, a, s, k.period));
+    }
+
+    template <class B> inline VFloat<B> easeInBack_helper(VFloat<B> t, float s) { return t * t * ((s + 1.0f) * t - s); }
+    template <class B> inline VFloat<B> easeOutBack_helper(VFloat<B> t, float s)
+    {
+        t -= 1.0f;
+        return t * t * ((s + 1.0f) * t + s) + 1.0f;
+    }
+    template <class B> inline VFloat<B> easeInBack(VFloat<B> t, const KernelParameters &k) { return easeInBack_helper(t, k.overshoot); }
+    template <class B> inline VFloat<B> easeOutBack(VFloat<B> t, const KernelParameters &k) { return easeOutBack_helper(t, k.overshoot); }
+    template <class B> inline VFloat<B> easeInOutBack(VFloat<B> t, const KernelParameters &k)
+    {
+        const float s = k.overshoot * 1.525f;
+        t *= 2.0f;
+        const VFloat<B> u = t - 2.0f;
+        return Select(t < 1.0f, 0.5f * (t * t * ((s + 1.0f) * t - s)), 0.5f * (u * u * ((s + 1.0f) * u + s) + 2.0f));
+    }
+    template <class B> inline VFloat<B> easeOutInBack(VFloat<B> t, const KernelParameters &k)
+    {
+        return Select(t < 0.5f, easeOutBack_helper(t * 2.0f, k.overshoot) * 0.5f,
+                      easeInBack_helper(t * 2.0f - 1.0f, k.overshoot) * 0.5f + 0.5f);
+    }
+
+    template <class B>
+    inline VFloat<B> easeOutBounce_helper(VFloat<B> t, float c, float a)
+    {
+        using F = VFloat<B>;
+        const VMask<B> second = t < (8 / 11.0f);
+        const VMask<B> third = t < (10 / 11.0f);
+        const F offset = Select(second, F(6 / 11.0f), Select(third, F(9 / 11.0f), F(21 / 22.0f)));
+        const F height = Select(second, F(0.75f), Select(third, F(0.9375f), F(0.984375f)));
+        const F u = t - offset;
+        const F bounce = -a * (1.0f - (7.5625f * u * u + height)) + c;
+        const F value = Select(t < (4 / 11.0f), c * (7.5625f * t * t), bounce);
+        return Select(t == 1.0f, F(c), value);
+    }
+    template <class B> inline VFloat<B> easeOutBounce(VFloat<B> t, const KernelParameters &k)
+    {
+        return easeOutBounce_helper(t, 1.0f, k.amplitude);
+    }
+    template <class B> inline VFloat<B> easeInBounce(VFloat<B> t, const KernelParameters &k)
+    {
+        return 1.0f - easeOutBounce_helper(1.0f - t, 1.0f, k.amplitude);
+    }
+    template <class B> inline VFloat<B> easeInOutBounce(VFloat<B> t, const KernelParameters &k)
+    {
+        const VFloat<B> in = easeInBounce(t * 2.0f, k) * 0.5f;
+        const VFloat<B> out = easeOutBounce(t * 2.0f - 1.0f, k) * 0.5f + 0.5f;
+        return Select(t < 0.5f, in, Select(t == 1.0f, VFloat<B>(1.0f), out));
+    }
+    template <class B> inline VFloat<B> easeOutInBounce(VFloat<B> t, const KernelParameters &k)
+    {
+        return Select(t < 0.5f, easeOutBounce_helper(t * 2.0f, 0.5f, k.amplitude),
+                      1.0f - easeOutBounce_helper(2.0f - t * 2.0f, 0.5f, k.amplitude));
+    }
+
+    // sin(pi * t - pi / 2) == -cos(pi * t)
+    template <class B> inline VFloat<B> qt_sinProgress(VFloat<B> t) { return -CosPi(t) * 0.5f + 0.5f; }
+    template <class B> inline VFloat<B> qt_smoothBeginEndMixFactor(VFloat<B> t)
+    {
+        return Min(Max(1.0f - t * 2.0f + 0.3f, VFloat<B>(0.0f)), VFloat<B>(1.0f));
+    }
+    template <class B> inline VFloat<B> easeInCurve(VFloat<B> t)
+    {
+        const VFloat<B> mix = qt_smoothBeginEndMixFactor(t);
+        return qt_sinProgress(t) * mix + t * (1.0f - mix);
+    }
+    template <class B> inline VFloat<B> easeOutCurve(VFloat<B> t)
+    {
+        const VFloat<B> mix = qt_smoothBeginEndMixFactor(1.0f - t);
+        return qt_sinProgress(t) * mix + t * (1.0f - mix);
+    }
+    // sin(2 pi t - pi / 2) == -cos(2 pi t) and cos(2 pi t - pi / 2) == sin(2 pi t)
+    template <class B> inline VFloat<B> easeSineCurve(VFloat<B> t) { return (1.0f - CosPi(t * 2.0f)) * 0.5f; }
+    template <class B> inline VFloat<B> easeCosineCurve(VFloat<B> t) { return (SinPi(t * 2.0f) + 1.0f) * 0.5f; }
+
+    template <class B, class Kernel>
+    inline void EaseLoop(const float *progress, float *values, size_t count, Kernel kernel)
+    {
+        size_t i = 0;
+        for (; i + B::kWidth <= count; i += B::kWidth) {
+            B::Store(values + i, kernel(VFloat<B>(B::Load(progress + i))).v);
+        }
+        if (i < count) {
+            // Pad the tail to a full vector rather than falling back to the scalar code
+            float tail[B::kWidth] = {};
+            for (size_t j = i; j < count; ++j) tail[j - i] = progress[j];
+            B::Store(tail, kernel(VFloat<B>(B::Load(tail))).v);
+            for (size_t j = i; j < count; ++j) values[j] = tail[j - i];
+        }
+    }
+
+    template <class B, VFloat<B> (*Kernel)(VFloat<B>)>
+    void EaseArray(const float *progress, float *values, size_t count, const CurveParameters &)
+    {
+        EaseLoop<B>(progress, values, count, [](VFloat<B> t) { return Kernel(t); });
+    }
+
+    template <class B, VFloat<B> (*Kernel)(VFloat<B>, const KernelParameters &)>
+    void EaseArrayWithParameters(const float *progress, float *values, size_t count, const CurveParameters &params)
+    {
+        const KernelParameters k(params);
+        EaseLoop<B>(progress, values, count, [&k](VFloat<B> t) { return Kernel(t, k); });
+    }
+
+    /**
+     * @brief Fills kernels[type] for every curve with a vectorized version, the others are left untouched.
+     */
+    template <class B>
+    void GetKernels(ArrayKernel *kernels)
+    {
+        kernels[int(CurveType::Linear)] = &EaseArray<B, &easeNone<B>>;
+        kernels[int(CurveType::InQuad)] = &EaseArray<B, &easeInQuad<B>>;
+        kernels[int(CurveType::OutQuad)] = &EaseArray<B, &easeOutQuad<B>>;
+        kernels[int(CurveType::InOutQuad)] = &EaseArray<B, &easeInOutQuad<B>>;
+        kernels[int(CurveType::OutInQuad)] = &EaseArray<B, &easeOutInQuad<B>>;
+        kernels[int(CurveType::InCubic)] = &EaseArray<B, &easeInCubic<B>>;
+        kernels[int(CurveType::OutCubic)] = &EaseArray<B, &easeOutCubic<B>>;
+        kernels[int(CurveType::InOutCubic)] = &EaseArray<B, &easeInOutCubic<B>>;
+        kernels[int(CurveType::OutInCubic)] = &EaseArray<B, &easeOutInCubic<B>>;
+        kernels[int(CurveType::InQuart)] = &EaseArray<B, &easeInQuart<B>>;
+        kernels[int(CurveType::OutQuart)] = &EaseArray<B, &easeOutQuart<B>>;
+        kernels[int(CurveType::InOutQuart)] = &EaseArray<B, &easeInOutQuart<B>>;
+        kernels[int(CurveType::OutInQuart)] = &EaseArray<B, &easeOutInQuart<B>>;
+        kernels[int(CurveType::InQuint)] = &EaseArray<B, &easeInQuint<B>>;
+        kernels[int(CurveType::OutQuint)] = &EaseArray<B, &easeOutQuint<B>>;
+        kernels[int(CurveType::InOutQuint)] = &EaseArray<B, &easeInOutQuint<B>>;
+        kernels[int(CurveType::OutInQuint)] = &EaseArray<B, &easeOutInQuint<B>>;
+        kernels[int(CurveType::InSine)] = &EaseArray<B, &easeInSine<B>>;
+        kernels[int(CurveType::OutSine)] = &EaseArray<B, &easeOutSine<B>>;
+        kernels[int(CurveType::InOutSine)] = &EaseArray<B, &easeInOutSine<B>>;
+        kernels[int(CurveType::OutInSine)] = &EaseArray<B, &easeOutInSine<B>>;
+        kernels[int(CurveType::InExpo)] = &EaseArray<B, &easeInExpo<B>>;
+        kernels[int(CurveType::OutExpo)] = &EaseArray<B, &easeOutExpo<B>>;
+        kernels[int(CurveType::InOutExpo)] = &EaseArray<B, &easeInOutExpo<B>>;
+        kernels[int(CurveType::OutInExpo)] = &EaseArray<B, &easeOutInExpo<B>>;
+        kernels[int(CurveType::InCirc)] = &EaseArray<B, &easeInCirc<B>>;
+        kernels[int(CurveType::OutCirc)] = &EaseArray<B, &easeOutCirc<B>>;
+        kernels[int(CurveType::InOutCirc)] = &EaseArray<B, &easeInOutCirc<B>>;
+        kernels[int(CurveType::OutInCirc)] = &EaseArray<B, &easeOutInCirc<B>>;
+        kernels[int(CurveType::InElastic)] = &EaseArrayWithParameters<B, &easeInElastic<B>>;
+        kernels[int(CurveType::OutElastic)] = &EaseArrayWithParameters<B, &easeOutElastic<B>>;
+        kernels[int(CurveType::InOutElastic)] = &EaseArrayWithParameters<B, &easeInOutElastic<B>>;
+        kernels[int(CurveType::OutInElastic)] = &EaseArrayWithParameters<B, &easeOutInElastic<B>>;
+        kernels[int(CurveType::InBack)] = &EaseArrayWithParameters<B, &easeInBack<B>>;
+        kernels[int(CurveType::OutBack)] = &EaseArrayWithParameters<B, &easeOutBack<B>>;
+        kernels[int(CurveType::InOutBack)] = &EaseArrayWithParameters<B, &easeInOutBack<B>>;
+        kernels[int(CurveType::OutInBack)] = &EaseArrayWithParameters<B, &easeOutInBack<B>>;
+        kernels[int(CurveType::InBounce)] = &EaseArrayWithParameters<B, &easeInBounce<B>>;
+        kernels[int(CurveType::OutBounce)] = &EaseArrayWithParameters<B, &easeOutBounce<B>>;
+        kernels[int(CurveType::InOutBounce)] = &EaseArrayWithParameters<B, &easeInOutBounce<B>>;
+        kernels[int(CurveType::OutInBounce)] = &EaseArrayWithParameters<B, &easeOutInBounce<B>>;
+        kernels[int(CurveType::InCurve)] = &EaseArray<B, &easeInCurve<B>>;
+        kernels[int(CurveType::OutCurve)] = &EaseArray<B, &easeOutCurve<B>>;
+        kernels[int(CurveType::SineCurve)] = &EaseArray<B, &easeSineCurve<B>>;
+        kernels[int(CurveType::CosineCurve)] = &EaseArray<B, &easeCosineCurve<B>>;
+    }
+} // namespace simd
+} // namespace anim
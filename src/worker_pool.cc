@@ -0,0 +1,84 @@
+#include <new>
+#include "worker_pool.h"
+
+namespace anim
+{
+    WorkerPool::WorkerPool(int thread_count)
+        : thread_count_(thread_count < 1 ? 1 : thread_count),
+          range_storage_(new char[sizeof(Range) * size_t(thread_count_) + kCacheLineSize - 1]) {
+        const uintptr_t storage = reinterpret_cast<uintptr_t>(range_storage_.get());
+        ranges_ = reinterpret_cast<Range *>((storage + kCacheLineSize - 1) & ~uintptr_t(kCacheLineSize - 1));
+        for (int i = 0; i < thread_count_; ++i) {
+            Range *range = new (&ranges_[i]) Range;
+            range->next.store(0, std::memory_order_relaxed);
+            range->end = 0;
+        }
+        for (int i = 1; i < thread_count_; ++i) {
+            threads_.emplace_back(&WorkerPool::WorkerLoop, this, i);
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            exit_ = true;
+        }
+        start_.notify_all();
+        for (auto &thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void WorkerPool::Run(size_t count, const std::function<void(size_t)> &task) {
+        size_t begin = 0;
+        for (int i = 0; i < thread_count_; ++i) {
+            const size_t end = count * size_t(i + 1) / size_t(thread_count_);
+            ranges_[i].next.store(begin, std::memory_order_relaxed);
+            ranges_[i].end = end;
+            begin = end;
+        }
+        {
+            // Publishes the ranges and the task to the workers
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            running_ = thread_count_ - 1;
+            ++generation_;
+        }
+        start_.notify_all();
+        Work(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return 0 == running_; });
+        task_ = nullptr;
+    }
+
+    void WorkerPool::WorkerLoop(int index) {
+        unsigned long generation = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [this, generation] { return exit_ || generation_ != generation; });
+                if (exit_) return;
+                generation = generation_;
+            }
+            Work(index);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --running_;
+            }
+            done_.notify_one();
+        }
+    }
+
+    void WorkerPool::Work(int index) {
+        const std::function<void(size_t)> &task = *task_;
+        // Own range first, then the others in turn
+        for (int n = 0; n < thread_count_; ++n) {
+            Range &range = ranges_[(index + n) % thread_count_];
+            for (;;) {
+                const size_t i = range.next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= range.end) break;
+                task(i);
+            }
+        }
+    }
+} // namespace anim
@@ -0,0 +1,70 @@
+/*
+ * Fixed pool of threads running the chunks of AnimationDriver's parallel tick.
+ */
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace anim
+{
+    class WorkerPool
+    {
+    public:
+        /**
+         * @param thread_count The number of threads running tasks, including the one calling Run().
+         */
+        explicit WorkerPool(int thread_count);
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+        ~WorkerPool();
+
+        int thread_count() const { return thread_count_; }
+
+        /**
+         * @brief Runs task(i) for every i in [0, count) and returns once all are done.
+         *
+         * The tasks are split in one contiguous range per thread, each thread takes tasks from the
+         * front of its range, then steals from the ranges of the others once its own is empty.
+         * The calling thread takes part as thread 0.
+         */
+        void Run(size_t count, const std::function<void(size_t)> &task);
+
+    private:
+        static const size_t kCacheLineSize = 64;
+
+        // One per cache line, the cursors are written by their owner and by thieves. Padded by
+        // hand and placed in an aligned buffer, as C++14 new ignores alignas beyond max_align_t
+        struct Range
+        {
+            std::atomic<size_t> next;
+            size_t end;
+            char padding[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+        };
+        static_assert(sizeof(Range) == kCacheLineSize, "Range must fill a cache line");
+        static_assert(std::is_trivially_destructible<Range>::value, "Ranges are never destroyed");
+
+        void WorkerLoop(int index);
+        void Work(int index);
+
+        const int thread_count_;
+        // thread_count_ ranges, from the first cache line boundary of range_storage_
+        std::unique_ptr<char[]> range_storage_;
+        Range *ranges_ = nullptr;
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable start_;
+        std::condition_variable done_;
+        const std::function<void(size_t)> *task_ = nullptr;
+        unsigned long generation_ = 0;
+        int running_ = 0;
+        bool exit_ = false;
+    };
+} // namespace anim
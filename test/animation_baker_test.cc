@@ -0,0 +1,88 @@
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "cc_animation_baker.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationBaker;
+using anim::CurveType;
+using anim::Duration;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::SimdLevel;
+using anim::ValueAnimation;
+
+static const Duration kInterval = std::chrono::microseconds(16667);
+
+static ValueAnimation<float> *MakeAnimation(int i) {
+    auto animation = new ValueAnimation<float>({
+        Keyframe<float>(0.0f, 0.0f, EasingCurve(CurveType(i % 40))),
+        Keyframe<float>(0.5f, float(i % 7), EasingCurve::Bezier(0.3f, 0.0f, 0.2f, 1.0f)),
+        Keyframe<float>(1.0f, 10.0f)});
+    animation->SetDuration(300 + i % 5 * 50);
+    animation->set_loop_count(1 + i % 3);
+    animation->set_loop_mode(i % 2 ? Animation::LoopMode::kReverse : Animation::LoopMode::kRestart);
+    animation->set_direction(i % 4 == 3 ? Animation::Direction::kReverse : Animation::Direction::kForward);
+    return animation;
+}
+
+static void TestMatchesEvaluate() {
+    const SimdLevel level = EasingCurve::simd_level();
+    for (int i = 0; i < 40; ++i) {
+        std::unique_ptr<ValueAnimation<float>> animation(MakeAnimation(i));
+        const size_t count = AnimationBaker::FrameCount(*animation, kInterval);
+        std::vector<float> frames(count);
+        // The scalar curves are those of Evaluate()
+        EasingCurve::SetSimdLevel(SimdLevel::kScalar);
+        animation->EvaluateFrames(Duration::zero(), kInterval, count, frames.data());
+        for (size_t f = 0; f < count; ++f) {
+            assert(animation->Evaluate(kInterval * long(f)) == frames[f]);
+        }
+        EasingCurve::SetSimdLevel(level);
+        animation->EvaluateFrames(Duration::zero(), kInterval, count, frames.data());
+        for (size_t f = 0; f < count; ++f) {
+            assert(std::fabs(animation->Evaluate(kInterval * long(f)) - frames[f]) < 1e-4f);
+        }
+    }
+}
+
+static void TestParallelBake() {
+    std::vector<std::unique_ptr<ValueAnimation<float>>> animations;
+    std::vector<const ValueAnimation<float> *> pointers;
+    for (int i = 0; i < 200; ++i) {
+        animations.emplace_back(MakeAnimation(i));
+        pointers.push_back(animations.back().get());
+    }
+    const size_t frame_count = 90;
+    std::vector<float> serial(pointers.size() * frame_count), parallel(serial.size(), -1.0f);
+    AnimationBaker baker;
+    baker.Bake(pointers.data(), pointers.size(), kInterval, frame_count, serial.data());
+    baker.set_thread_count(3);
+    assert(3 == baker.thread_count());
+    baker.Bake(pointers.data(), pointers.size(), kInterval, frame_count, parallel.data());
+    assert(serial == parallel);
+    for (size_t a = 0; a < pointers.size(); a += 17) {
+        assert(pointers[a]->Evaluate(kInterval * 30) == serial[a * frame_count + 30]);
+    }
+
+    // One long animation split in chunks
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    animation.SetDuration(60000);
+    const size_t count = AnimationBaker::FrameCount(animation, kInterval);
+    assert(3600 == count);
+    std::vector<float> whole(count), chunked(count);
+    animation.EvaluateFrames(Duration::zero(), kInterval, count, whole.data());
+    baker.Bake(animation, kInterval, count, chunked.data());
+    assert(whole == chunked);
+
+    animation.set_loop_count(Animation::INFINITE);
+    assert(0 == AnimationBaker::FrameCount(animation, kInterval));
+}
+
+int main() {
+    TestMatchesEvaluate();
+    TestParallelBake();
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <cassert>
+#include <memory>
+#include <vector>
+#include "cc_animation_batch.hpp"
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::AnimationDriver;
+using anim::CurveType;
+using anim::FloatAnimationBatch;
+using anim::ValueAnimation;
+
+int main() {
+    // The vectorized curves are only close to the scalar ones, compare against the exact path
+    anim::EasingCurve::SetSimdLevel(anim::SimdLevel::kScalar);
+    AnimationDriver driver;
+    FloatAnimationBatch batch;
+    std::vector<std::unique_ptr<ValueAnimation<float>>> animations;
+    std::vector<float> expected;
+    expected.reserve(anim::kCurveTypeCount);
+    for (int i = 0; i < anim::kCurveTypeCount; ++i) {
+        const float start = float(i) * 3.0f;
+        const float end = 100.0f - float(i);
+        const long duration = 50L + 10L * i;
+        batch.Add(start, end, duration, CurveType(i));
+        animations.emplace_back(new ValueAnimation<float>(start, end));
+        animations.back()->set_driver(&driver);
+        animations.back()->SetDuration(duration);
+        animations.back()->set_easing_curve(anim::EasingCurve(CurveType(i)));
+        expected.push_back(0.0f);
+        float *slot = &expected.back();
+        animations.back()->subscriber_ = [slot](const float &value) { *slot = value; };
+        animations.back()->Start();
+    }
+    std::vector<float> values(batch.size());
+    // The same tweens written to a member of an array of structs, across several blocks
+    struct Particle
+    {
+        float x, y;
+    };
+    FloatAnimationBatch strided_batch;
+    const size_t repeats = 20;
+    for (size_t r = 0; r < repeats; ++r) {
+        for (int i = 0; i < anim::kCurveTypeCount; ++i) {
+            strided_batch.Add(float(i) * 3.0f, 100.0f - float(i), 50L + 10L * i, CurveType(i));
+        }
+    }
+    std::vector<Particle> particles(strided_batch.size(), Particle{0.0f, -1.0f});
+
+    driver.Tick(0);
+    for (long frame_time = 7; frame_time < 600; frame_time += 7) {
+        driver.Tick(frame_time);
+        batch.Advance(7, values.data());
+        strided_batch.Advance(7, &particles[0].x, sizeof(Particle));
+        for (size_t i = 0; i < batch.size(); ++i) {
+            assert(values[i] == expected[i]);
+        }
+        for (size_t i = 0; i < particles.size(); ++i) {
+            assert(particles[i].x == expected[i % batch.size()]);
+            assert(particles[i].y == -1.0f);
+        }
+    }
+    for (size_t i = 0; i < batch.size(); ++i) {
+        assert(batch.IsFinished(i));
+    }
+    return 0;
+}
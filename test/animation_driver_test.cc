@@ -0,0 +1,78 @@
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::ValueAnimation;
+
+int main() {
+    AnimationDriver driver;
+    std::vector<std::unique_ptr<ValueAnimation<float>>> animations;
+    for (int i = 0; i < 4; ++i) {
+        animations.emplace_back(new ValueAnimation<float>(0.0f, 1.0f));
+        animations.back()->set_driver(&driver);
+        animations.back()->SetDuration(100 * (i + 1));
+    }
+    assert(driver.IsIdle());
+
+    for (auto &animation : animations) animation->Start();
+    assert(driver.animation_count() == 4);
+
+    // Stopping another animation from inside a tick must not disturb the iteration
+    float last_value = -1.0f;
+    animations[0]->subscriber_ = [&](const float &value) {
+        last_value = value;
+        animations[3]->Stop();
+    };
+
+    driver.Tick(1000);
+    driver.Tick(1050);
+    assert(last_value > 0.0f);
+    assert(animations[3]->state() == Animation::State::kStopped);
+    assert(driver.animation_count() == 3);
+
+    driver.Tick(1100);
+    assert(last_value == 1.0f);
+    assert(animations[0]->state() == Animation::State::kStopped);
+    assert(driver.animation_count() == 2);
+
+    // Paused animations leave the driver and skip the paused interval on resume
+    animations[2]->Pause();
+    assert(driver.animation_count() == 1);
+    driver.Tick(1200);
+    assert(animations[1]->state() == Animation::State::kStopped);
+    animations[2]->Resume();
+    driver.Tick(5000);
+    assert(animations[2]->state() == Animation::State::kRunning);
+    assert(animations[2]->GetCurrentTime() == 100);
+
+    // Destroying a running animation unregisters it
+    animations[2].reset();
+    assert(driver.IsIdle());
+    driver.Tick(6000);
+
+    // Frame times finer than a millisecond are kept, 240 Hz frames advance by 1/240 s each
+    using std::chrono::nanoseconds;
+    ValueAnimation<float> precise(0.0f, 1.0f);
+    precise.set_driver(&driver);
+    precise.SetDuration(anim::Duration(std::chrono::seconds(1)));
+    precise.set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+    float value = 0.0f;
+    precise.subscriber_ = [&value](const float &v) { value = v; };
+    precise.Start();
+    const anim::Duration origin = std::chrono::seconds(7);
+    for (long frame = 0; frame <= 10; ++frame) {
+        driver.Tick(origin + nanoseconds(1000000000L * frame / 240));
+    }
+    assert(precise.current_time() == nanoseconds(1000000000L * 10 / 240));
+    assert(std::fabs(value - 10.0f / 240.0f) < 1e-6f);
+    // The millisecond API truncates
+    assert(precise.GetCurrentTime() == 41);
+    assert(precise.GetDuration() == 1000);
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_set.hpp"
+#include "cc_clip_file.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::AnimationListener;
+using anim::AnimationSet;
+using anim::ListenerList;
+using anim::ValueAnimation;
+
+static size_t g_allocations = 0;
+
+void *operator new(size_t size) {
+    ++g_allocations;
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+struct CountingListener : AnimationListener {
+    int repeats = 0;
+    void OnAnimationRepeat(Animation &) override { ++repeats; }
+};
+
+static void TestSizes() {
+    // Upper bounds on 64-bit targets: the tick state of Animation in its first cache line, a
+    // ValueAnimation<float> below the 248 bytes it took with its keyframes in a std::vector
+    if (8 != sizeof(void *)) return;
+    assert(sizeof(Animation) <= 64);
+    assert(sizeof(ValueAnimation<float>) <= 216);
+    assert(sizeof(anim::EasingCurve) <= 32);
+    assert(sizeof(ListenerList<AnimationListener>) <= 24);
+
+    // The hot fields of ValueAnimation follow those of Animation and come before subscriber_, the
+    // last member, so what a tick touches stays within the first 3 cache lines. offsetof is only
+    // defined for standard layout types, the offset is taken from an instance
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    const size_t subscriber_offset = size_t(reinterpret_cast<const char *>(&animation.subscriber_)
+                                            - reinterpret_cast<const char *>(&animation));
+    assert(subscriber_offset <= 3 * 64);
+    assert(subscriber_offset + sizeof(animation.subscriber_) == sizeof(animation));
+}
+
+static void TestStartEndValuesInline() {
+    const size_t allocations = g_allocations;
+    ValueAnimation<float> animation(2.0f, 4.0f);
+    animation.set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+    animation.SetDuration(100L);
+    assert(3.0f == animation.Evaluate(50L));
+    assert(allocations == g_allocations);
+
+    // The keyframes are still there when asked for
+    assert(2 == animation.keyframes().size() && animation.shared_clip());
+    assert(4.0f == animation.keyframes()[1].value() && 1.0f == animation.keyframes()[1].progress());
+    assert(3.0f == animation.Evaluate(50L));
+
+    // So are tweens given as two keyframes, with the curve of the first one
+    const std::vector<anim::Keyframe<float>> keyframes = {
+        anim::Keyframe<float>(0.0f, 0.0f, anim::EasingCurve(anim::CurveType::OutCubic)),
+        anim::Keyframe<float>(1.0f, 48.0f)};
+    std::vector<anim::Keyframe<float>> moved = keyframes;
+    const size_t before = g_allocations;
+    // Only the curve, in the cold data
+    ValueAnimation<float> tween(std::move(moved));
+    assert(before + 1 == g_allocations);
+    ValueAnimation<float> track(anim::KeyframeClip<float>::Create(keyframes));
+    for (long msecs = 0; msecs <= 300; msecs += 25) {
+        assert(track.Evaluate(msecs) == tween.Evaluate(msecs));
+    }
+    assert(anim::CurveType::OutCubic == tween.keyframes()[0].easing_curve().type());
+}
+
+static void TestColdDataOnDemand() {
+    AnimationDriver driver;
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    animation.set_driver(&driver);
+    CountingListener listener;
+    // Once the driver's list has room
+    animation.Start();
+    animation.Stop();
+    size_t allocations = g_allocations;
+    // Defaults don't allocate, nor does ticking
+    animation.set_start_delay(anim::Duration::zero());
+    animation.set_change_log(nullptr, 0);
+    animation.SetStateListener(nullptr);
+    assert(anim::Duration::zero() == animation.start_delay());
+    assert(nullptr == animation.group() && nullptr == animation.change_log() && !animation.GetStateListener());
+    animation.Start();
+    driver.Tick(0L);
+    driver.Tick(100L);
+    assert(allocations == g_allocations);
+    // Listeners are cold, the first one allocates the cold data and a second one fits inline
+    animation.Stop();
+    CountingListener second;
+    animation.AddAnimationListener(&listener);
+    animation.AddAnimationListener(&second);
+    assert(allocations + 1 == g_allocations);
+    allocations = g_allocations;
+    animation.Start();
+    driver.Tick(200L);
+    driver.Tick(300L);
+    assert(allocations == g_allocations);
+    animation.RemoveAnimationListener(&second);
+
+    // The configuration still works once set
+    animation.Stop();
+    int states = 0;
+    animation.SetStateListener([&states](Animation::State) { ++states; });
+    animation.set_start_delay(std::chrono::milliseconds(20));
+    assert(std::chrono::milliseconds(20) == animation.start_delay());
+    animation.Start();
+    assert(1 == states);
+    animation.Stop();
+    {
+        AnimationSet group;
+        group.AddAnimation(&animation);
+        assert(&group == animation.group());
+    }
+    assert(nullptr == animation.group());
+    animation.RemoveAnimationListener(&listener);
+}
+
+static void TestBakedClipsAllocateNothing() {
+    std::vector<anim::Keyframe<float>> keyframes;
+    for (int i = 0; i <= 40; ++i) {
+        keyframes.push_back(anim::Keyframe<float>(i / 40.0f, float(i % 7), anim::EasingCurve(anim::CurveType::OutQuad)));
+    }
+    anim::ClipWriter writer;
+    assert(writer.AddClip("track", keyframes, std::chrono::milliseconds(400)));
+    const std::vector<char> serialized = writer.Serialize();
+    // Aligned like a mapping
+    struct alignas(16) Block { char bytes[16]; };
+    std::vector<Block> blocks((serialized.size() + sizeof(Block) - 1) / sizeof(Block));
+    std::memcpy(blocks.data(), serialized.data(), serialized.size());
+    anim::ClipFile file;
+    assert(file.OpenMemory(blocks.data(), serialized.size()));
+
+    AnimationDriver driver;
+    anim::BakedClip<float> clip;
+    assert(file.GetClip("track", &clip));
+    // The first animation playing the clip decodes its curves, once the driver's list has room for two
+    ValueAnimation<float> first(clip), other(0.0f, 1.0f);
+    for (auto animation : {&first, &other}) {
+        animation->set_driver(&driver);
+        animation->Start();
+    }
+    driver.Tick(0L);
+    other.Stop();
+    const size_t allocations = g_allocations;
+    // The index and curves are the file's, other animations only point to them
+    assert(file.GetClip("track", &clip));
+    ValueAnimation<float> animation(clip);
+    animation.set_driver(&driver);
+    animation.Start();
+    for (long msecs = 0; msecs <= 400; msecs += 10) {
+        driver.Tick(msecs);
+    }
+    assert(allocations == g_allocations);
+    assert(float(40 % 7) == animation.current_value());
+}
+
+static void TestListenersPastInlineCapacity() {
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    std::vector<CountingListener> listeners(5);
+    for (auto &listener : listeners) {
+        animation.AddAnimationListener(&listener);
+    }
+    animation.SetDuration(10L);
+    animation.set_loop_count(2);
+    animation.SetCurrentTime(15L);
+    for (auto &listener : listeners) {
+        assert(1 == listener.repeats);
+    }
+    // Back to fewer listeners than the inline capacity, still on the heap storage
+    for (size_t i = 1; i < listeners.size(); ++i) {
+        animation.RemoveAnimationListener(&listeners[i]);
+    }
+    animation.SetCurrentTime(5L);
+    assert(2 == listeners[0].repeats && 1 == listeners[1].repeats);
+    animation.RemoveAnimationListener(&listeners[0]);
+}
+
+int main() {
+    TestSizes();
+    TestStartEndValuesInline();
+    TestColdDataOnDemand();
+    TestBakedClipsAllocateNothing();
+    TestListenersPastInlineCapacity();
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <cassert>
+#include <string>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_listener_list.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::AnimationListener;
+using anim::ListenerList;
+using anim::ValueAnimation;
+
+struct Counter
+{
+    int calls = 0;
+};
+
+struct Recorder : AnimationListener
+{
+    std::string events;
+    Animation *remove_on_repeat = nullptr;
+
+    void OnAnimationStart(Animation &) override { events += "S"; }
+    void OnAnimationEnd(Animation &) override { events += "E"; }
+    void OnAnimationCancel(Animation &) override { events += "C"; }
+    void OnAnimationRepeat(Animation &animation) override {
+        events += "R";
+        if (remove_on_repeat) animation.RemoveAnimationListener(this);
+    }
+    void OnAnimationPause(Animation &) override { events += "P"; }
+    void OnAnimationResume(Animation &) override { events += "U"; }
+};
+
+struct ValueRecorder : anim::ValueUpdateListener<float>
+{
+    std::vector<float> values;
+    void OnUpdate(float value) override { values.push_back(value); }
+};
+
+static void TestListenerList() {
+    ListenerList<Counter, 2> list;
+    std::vector<Counter> counters(5);
+    for (auto &counter : counters) list.Add(&counter);
+    list.Add(&counters[0]);
+    assert(list.size() == 5);
+
+    // Removal during dispatch, of the current and of a later listener, and additions
+    Counter late;
+    int order = 0;
+    list.Dispatch([&](Counter &counter) {
+        counter.calls = ++order;
+        if (&counter == &counters[1]) {
+            list.Remove(&counters[1]);
+            list.Remove(&counters[3]);
+            list.Add(&late);
+        }
+    });
+    assert(counters[0].calls == 1 && counters[1].calls == 2 && counters[2].calls == 3);
+    assert(counters[3].calls == 0 && counters[4].calls == 4 && late.calls == 0);
+    assert(list.size() == 4);
+
+    // Order is kept after the compaction
+    order = 0;
+    list.Dispatch([&](Counter &counter) { counter.calls = ++order; });
+    assert(counters[0].calls == 1 && counters[2].calls == 2 && counters[4].calls == 3 && late.calls == 4);
+    assert(!list.Remove(&counters[1]));
+    for (auto &counter : counters) list.Remove(&counter);
+    list.Remove(&late);
+    assert(list.empty());
+}
+
+int main() {
+    TestListenerList();
+
+    AnimationDriver driver;
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    animation.set_driver(&driver);
+    animation.SetDuration(100L);
+    animation.set_loop_count(3);
+    Recorder recorder;
+    ValueRecorder values;
+    animation.AddAnimationListener(&recorder);
+    animation.AddValueListener(&values);
+
+    animation.Start();
+    for (long time = 0; time <= 400L; time += 10) {
+        driver.Tick(time);
+    }
+    assert(recorder.events == "SRRE");
+    assert(!values.values.empty() && values.values.back() == 1.0f);
+
+    // Restarting doesn't look like a repeat
+    recorder.events.clear();
+    animation.Start();
+    driver.Tick(1000L);
+    driver.Tick(1050L);
+    animation.Pause();
+    animation.Pause();
+    animation.Resume();
+    animation.Cancel();
+    animation.Cancel();
+    assert(recorder.events == "SPUCE");
+
+    // A listener removing itself from its callback
+    recorder.events.clear();
+    recorder.remove_on_repeat = &animation;
+    animation.Start();
+    for (long time = 2000L; time <= 2400L; time += 10) {
+        driver.Tick(time);
+    }
+    assert(recorder.events == "SR");
+    animation.RemoveValueListener(&values);
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <cassert>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_pool.hpp"
+#include "cc_property_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::AnimationPool;
+using anim::ClipRef;
+using anim::KeyframeClip;
+using anim::PropertyAnimation;
+using anim::ValueAnimation;
+
+using Ripple = PropertyAnimation<float>;
+
+static void TestRecycling() {
+    AnimationDriver driver;
+    const ClipRef<float> clip = KeyframeClip<float>::Create({{0.0f, 0.0f}, {1.0f, 1.0f}}, std::chrono::milliseconds(50));
+    std::vector<float> radii(3);
+    {
+        AnimationPool<Ripple> pool(&driver);
+        Ripple *first = pool.Launch(&radii[0], clip);
+        Ripple *second = pool.Launch(&radii[1], clip);
+        assert(2 == pool.live_count() && AnimationPool<Ripple>::kChunkSize == pool.capacity());
+        assert(Animation::State::kRunning == first->state() && &driver == first->driver());
+        driver.Tick(0L);
+        driver.Tick(100L);
+        assert(1.0f == radii[0] && 1.0f == radii[1]);
+        // Ended, not recycled before the next tick
+        assert(2 == pool.live_count());
+        driver.Tick(200L);
+        assert(0 == pool.live_count() && 1 == clip->ref_count());
+
+        // Slots are reused, the most recently freed first
+        Ripple *third = pool.Launch(&radii[2], clip);
+        assert(third == first || third == second);
+
+        // Restarted before it was recycled: kept
+        driver.Tick(300L);
+        driver.Tick(400L);
+        third->Start();
+        driver.Tick(500L);
+        assert(1 == pool.live_count() && Animation::State::kRunning == third->state());
+
+        // Acquired but configured by the caller, cancelled animations are recycled too
+        Ripple *cancelled = pool.Acquire(&radii[0], clip);
+        cancelled->SetDuration(1000);
+        cancelled->Start();
+        cancelled->Cancel();
+        driver.Tick(600L);
+        driver.Tick(700L);
+        assert(0 == pool.live_count());
+
+        // Growing by chunks
+        pool.Reserve(100);
+        assert(2 * AnimationPool<Ripple>::kChunkSize == pool.capacity());
+        for (int i = 0; i < 100; ++i) {
+            pool.Launch(&radii[i % 3], clip);
+        }
+        assert(100 == pool.live_count() && 2 * AnimationPool<Ripple>::kChunkSize == pool.capacity());
+        assert(101 == clip->ref_count());
+    }
+    // Destroying the pool destroys the animations still alive, which unregister
+    assert(1 == clip->ref_count());
+    assert(driver.IsIdle());
+}
+
+int main() {
+    TestRecycling();
+    return 0;
+}
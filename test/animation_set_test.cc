@@ -0,0 +1,193 @@
+#include <cassert>
+#include <memory>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_set.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::AnimationSet;
+
+// Records how often the group updates it
+class Probe : public Animation
+{
+public:
+    explicit Probe(long duration) : duration_(std::chrono::milliseconds(duration)) {}
+    using Animation::SetDuration;
+    void SetDuration(anim::Duration duration) override { duration_ = duration; }
+    anim::Duration duration() const override { return duration_; }
+    int updates = 0;
+
+protected:
+    void UpdateCurrentTime(anim::Duration) override { ++updates; }
+
+private:
+    anim::Duration duration_;
+};
+
+static void TestSequential() {
+    AnimationDriver driver;
+    Probe a(100), b(200), c(100);
+    AnimationSet group(AnimationSet::Ordering::kSequential);
+    group.set_driver(&driver);
+    group.AddAnimation(&a);
+    group.AddAnimation(&b);
+    group.AddAnimation(&c);
+    assert(group.GetDuration() == 400);
+    assert(a.group() == &group);
+
+    group.Start();
+    assert(driver.animation_count() == 1);
+    driver.Tick(0);
+    driver.Tick(50);
+    assert(a.GetCurrentTime() == 50 && a.state() == Animation::State::kRunning);
+    assert(b.state() == Animation::State::kStopped);
+    // A frame skipping the end of a settles it on its end
+    driver.Tick(150);
+    assert(a.GetCurrentTime() == 100 && a.state() == Animation::State::kStopped);
+    assert(b.GetCurrentTime() == 50 && b.state() == Animation::State::kRunning);
+    driver.Tick(380);
+    assert(b.GetCurrentTime() == 200 && c.GetCurrentTime() == 80);
+    driver.Tick(500);
+    assert(c.GetCurrentTime() == 100);
+    assert(group.state() == Animation::State::kStopped);
+    assert(c.state() == Animation::State::kStopped);
+    assert(driver.IsIdle());
+}
+
+static void TestParallelNestedLoops() {
+    AnimationDriver driver;
+    Probe a(100), b(300), c(50), d(50);
+    AnimationSet inner(AnimationSet::Ordering::kSequential);
+    inner.AddAnimation(&c);
+    inner.AddAnimation(&d);
+    inner.set_loop_count(2);
+    AnimationSet outer(AnimationSet::Ordering::kParallel);
+    outer.set_driver(&driver);
+    outer.AddAnimation(&a);
+    outer.AddAnimation(&b);
+    outer.AddAnimation(&inner);
+    outer.set_loop_count(2);
+    assert(inner.GetTotalDuration() == 200);
+    assert(outer.GetDuration() == 300);
+
+    outer.Start();
+    driver.Tick(0);
+    driver.Tick(120);
+    assert(a.GetCurrentTime() == 100 && b.GetCurrentTime() == 120);
+    // Second loop of inner, back in c
+    assert(c.GetCurrentTime() == 20 && d.GetCurrentTime() == 0);
+    // Into the second loop of outer, everything starts over
+    driver.Tick(330);
+    assert(a.GetCurrentTime() == 30 && b.GetCurrentTime() == 30);
+    assert(c.GetCurrentTime() == 30 && d.GetCurrentTime() == 0);
+    driver.Tick(700);
+    assert(outer.state() == Animation::State::kStopped);
+    assert(a.GetCurrentTime() == 100 && b.GetCurrentTime() == 300 && d.GetCurrentTime() == 50);
+}
+
+static void TestReverse() {
+    AnimationDriver driver;
+    Probe a(100), b(100);
+    AnimationSet group(AnimationSet::Ordering::kSequential);
+    group.set_driver(&driver);
+    group.AddAnimation(&a);
+    group.AddAnimation(&b);
+    group.set_direction(Animation::Direction::kReverse);
+    group.Start();
+    driver.Tick(0);
+    assert(a.GetCurrentTime() == 100 && b.GetCurrentTime() == 100);
+    driver.Tick(30);
+    assert(b.GetCurrentTime() == 70 && b.direction() == Animation::Direction::kReverse);
+    driver.Tick(150);
+    assert(b.GetCurrentTime() == 0 && a.GetCurrentTime() == 50);
+    driver.Tick(250);
+    assert(a.GetCurrentTime() == 0 && group.state() == Animation::State::kStopped);
+}
+
+static void TestReverseLoops() {
+    AnimationDriver driver;
+    Probe a(60), b(40);
+    AnimationSet group(AnimationSet::Ordering::kSequential);
+    group.set_driver(&driver);
+    group.AddAnimation(&a);
+    group.AddAnimation(&b);
+    group.set_loop_count(2);
+    group.set_loop_mode(Animation::LoopMode::kReverse);
+    group.Start();
+    driver.Tick(0);
+    driver.Tick(80);
+    assert(a.GetCurrentTime() == 60 && b.GetCurrentTime() == 20);
+    // The second loop plays the children backwards, from where the first one left them
+    driver.Tick(120);
+    assert(a.GetCurrentTime() == 60 && b.GetCurrentTime() == 20);
+    driver.Tick(150);
+    assert(a.GetCurrentTime() == 50 && b.GetCurrentTime() == 0);
+    driver.Tick(180);
+    assert(a.GetCurrentTime() == 20);
+    driver.Tick(250);
+    assert(a.GetCurrentTime() == 0 && b.GetCurrentTime() == 0);
+    assert(group.state() == Animation::State::kStopped);
+
+    // A frame skipping a whole loop goes through both ends, into the third loop played forwards
+    Probe c(100);
+    AnimationSet looping;
+    looping.set_driver(&driver);
+    looping.AddAnimation(&c);
+    looping.set_loop_count(4);
+    looping.set_loop_mode(Animation::LoopMode::kReverse);
+    looping.Start();
+    driver.Tick(300);
+    driver.Tick(330);
+    assert(c.GetCurrentTime() == 30);
+    driver.Tick(560);
+    assert(c.GetCurrentTime() == 60);
+    driver.Tick(620);
+    assert(c.GetCurrentTime() == 80);
+    driver.Tick(800);
+    assert(c.GetCurrentTime() == 0 && looping.state() == Animation::State::kStopped);
+}
+
+static void TestSeek() {
+    const int count = 1000;
+    std::vector<std::unique_ptr<Probe>> probes;
+    AnimationSet group(AnimationSet::Ordering::kSequential);
+    for (int i = 0; i < count; ++i) {
+        probes.emplace_back(new Probe(10));
+        group.AddAnimation(probes.back().get());
+    }
+    group.Start();
+    group.Pause();
+    for (auto &probe : probes) probe->updates = 0;
+
+    // Seeking within a child only visits that child
+    group.SetCurrentTime(5005);
+    group.SetCurrentTime(5007);
+    assert(probes[500]->GetCurrentTime() == 7);
+    assert(probes[499]->GetCurrentTime() == 10 && probes[501]->updates == 0);
+    const int updates = probes[500]->updates;
+    group.SetCurrentTime(5008);
+    assert(probes[500]->updates == updates + 1 && probes[499]->updates == 1);
+
+    // Seeking back rewinds the children passed on the way
+    group.SetCurrentTime(2005);
+    assert(probes[200]->GetCurrentTime() == 5);
+    assert(probes[300]->GetCurrentTime() == 0 && probes[500]->GetCurrentTime() == 0);
+    assert(probes[100]->updates == 1);
+
+    // Removing and destroying children
+    group.RemoveAnimation(probes[0].get());
+    assert(probes[0]->group() == nullptr && group.animation_count() == count - 1);
+    probes.pop_back();
+    assert(group.animation_count() == count - 2);
+    group.Stop();
+}
+
+int main() {
+    TestSequential();
+    TestParallelNestedLoops();
+    TestReverse();
+    TestReverseLoops();
+    TestSeek();
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_clip_file.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::AnimationDriver;
+using anim::BakedClip;
+using anim::ClipFile;
+using anim::ClipWriter;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::ValueAnimation;
+
+// OpenMemory() wants the clips aligned like a mapping
+struct alignas(16) Block
+{
+    char bytes[16];
+};
+
+static std::vector<Block> ToBlocks(const std::vector<char> &file) {
+    std::vector<Block> blocks((file.size() + sizeof(Block) - 1) / sizeof(Block));
+    std::memcpy(blocks.data(), file.data(), file.size());
+    return blocks;
+}
+
+static std::vector<Keyframe<float>> FadeKeyframes() {
+    return {Keyframe<float>(0.0f, 0.0f, EasingCurve(CurveType::OutBack)),
+            Keyframe<float>(0.4f, 0.8f, EasingCurve::Bezier(0.3f, 0.0f, 0.2f, 1.0f)),
+            Keyframe<float>(0.7f, 0.5f), Keyframe<float>(1.0f, 1.0f)};
+}
+
+static std::vector<Keyframe<double>> TrackKeyframes() {
+    // Enough keyframes for a bucket index, linear so no curves are stored
+    std::vector<Keyframe<double>> keyframes;
+    for (int i = 0; i <= 40; ++i) {
+        keyframes.push_back(Keyframe<double>(i / 40.0f, (i * 7 % 11) * 0.5));
+    }
+    return keyframes;
+}
+
+// Both animations go through the same frames and seeks and must compute the same values
+template <typename T>
+static void ExpectSameValues(ValueAnimation<T> &expected, ValueAnimation<T> &baked) {
+    AnimationDriver driver;
+    for (auto animation : {&expected, &baked}) {
+        animation->set_driver(&driver);
+        animation->set_easing_curve(EasingCurve(CurveType::Linear));
+        animation->Start();
+    }
+    assert(expected.duration() == baked.duration());
+    assert(expected.keyframe_count() == baked.keyframe_count());
+    const long duration = expected.GetDuration();
+    for (long time = 0; time <= duration; time += 7) {
+        driver.Tick(time);
+        assert(expected.current_value() == baked.current_value());
+    }
+    for (long time : {duration / 2, 3L, duration - 1, duration / 5}) {
+        expected.SetCurrentTime(time);
+        baked.SetCurrentTime(time);
+        assert(expected.current_value() == baked.current_value());
+    }
+}
+
+static std::vector<char> BakeClips() {
+    ClipWriter writer;
+    assert(writer.AddClip("fade", FadeKeyframes(), std::chrono::milliseconds(400)));
+    assert(writer.AddClip("track", TrackKeyframes(), std::chrono::milliseconds(1000)));
+    assert(writer.AddClip("count", std::vector<Keyframe<int>>{{0.0f, 0}, {1.0f, 10}}, std::chrono::milliseconds(100)));
+    // Names are unique, custom curves have no record
+    assert(!writer.AddClip("fade", FadeKeyframes(), std::chrono::milliseconds(400)));
+    assert(!writer.AddClip("custom", std::vector<Keyframe<float>>{
+        {0.0f, 0.0f, EasingCurve([](float p) { return p * p; })}, {1.0f, 1.0f}}, std::chrono::milliseconds(100)));
+    assert(3 == writer.clip_count());
+    return writer.Serialize();
+}
+
+static void TestEvaluatesInPlace() {
+    const std::vector<Block> blocks = ToBlocks(BakeClips());
+    ClipFile file;
+    assert(file.OpenMemory(blocks.data(), blocks.size() * sizeof(Block)));
+    assert(!file.is_mapped());
+    assert(3 == file.clip_count());
+    // Sorted by name
+    assert(0 == std::strcmp("count", file.clip_name(0)));
+    assert(2 == file.FindClip("track"));
+    assert(-1 == file.FindClip("missing"));
+
+    BakedClip<float> fade;
+    assert(file.GetClip("fade", &fade));
+    assert(4 == fade.count && nullptr != fade.index->curves() && 0 == fade.index->index().bucket_count());
+    // Decoded once, then shared
+    assert(fade.index->curves() == fade.index->curves());
+    assert(CurveType::OutBack == fade.index->curves()[0].type() && CurveType::Linear == fade.index->curves()[2].type());
+    // The values are read from the file, not copied
+    assert(reinterpret_cast<const char *>(fade.values) > reinterpret_cast<const char *>(blocks.data()));
+    ValueAnimation<float> fade_expected(FadeKeyframes()), fade_baked(fade);
+    fade_expected.SetDuration(400);
+    ExpectSameValues(fade_expected, fade_baked);
+
+    BakedClip<double> track;
+    assert(file.GetClip("track", &track));
+    assert(nullptr == track.index->curves() && track.index->index().bucket_count() > 0);
+    ValueAnimation<double> track_expected(TrackKeyframes()), track_baked(track);
+    track_expected.SetDuration(1000);
+    ExpectSameValues(track_expected, track_baked);
+
+    // A clip is only read as the type it was baked with
+    BakedClip<double> wrong;
+    assert(!file.GetClip("fade", &wrong));
+    BakedClip<int> count;
+    assert(file.GetClip("count", &count) && 10 == count.values[1]);
+
+    // A clip without an index, not from a clip file, is not played
+    BakedClip<float> unindexed = fade;
+    unindexed.index = nullptr;
+    ValueAnimation<float> empty(unindexed);
+    assert(0 == empty.keyframe_count() && 0.0f == empty.Evaluate(100L));
+}
+
+static void TestRejectsDamagedFiles() {
+    const std::vector<char> good = BakeClips();
+    ClipFile file;
+
+    std::vector<char> bad = good;
+    bad[0] = 'X';
+    std::vector<Block> blocks = ToBlocks(bad);
+    assert(!file.OpenMemory(blocks.data(), bad.size()));
+
+    // An older version, without a name table
+    bad = good;
+    bad[4] = 1;
+    blocks = ToBlocks(bad);
+    assert(!file.OpenMemory(blocks.data(), bad.size()));
+    assert(!file.IsOpen() && 0 == file.clip_count());
+
+    // Truncated
+    blocks = ToBlocks(good);
+    assert(!file.OpenMemory(blocks.data(), good.size() - 16));
+    assert(file.OpenMemory(blocks.data(), good.size()));
+}
+
+static void TestFindsEveryName() {
+    ClipWriter writer;
+    const std::vector<Keyframe<float>> keyframes = {{0.0f, 0.0f}, {1.0f, 1.0f}};
+    for (int i = 0; i < 1000; ++i) {
+        assert(writer.AddClip("clip_" + std::to_string(i), keyframes, std::chrono::milliseconds(i + 1)));
+    }
+    const std::vector<char> serialized = writer.Serialize();
+    const std::vector<Block> blocks = ToBlocks(serialized);
+    ClipFile file;
+    assert(file.OpenMemory(blocks.data(), serialized.size()));
+    for (int i = 0; i < 1000; ++i) {
+        const std::string name = "clip_" + std::to_string(i);
+        const long index = file.FindClip(name.c_str());
+        assert(index >= 0 && name == file.clip_name(size_t(index)));
+        BakedClip<float> clip;
+        assert(file.GetClip(name.c_str(), &clip) && std::chrono::milliseconds(i + 1) == clip.duration);
+    }
+    assert(-1 == file.FindClip("clip_1000") && -1 == file.FindClip("") && -1 == file.FindClip("clip_"));
+
+    // Not found, rather than read out of the directory, through a damaged name table
+    std::vector<Block> damaged = blocks;
+    char *data = reinterpret_cast<char *>(damaged.data());
+    uint64_t slots_offset;
+    uint32_t slot_count;
+    std::memcpy(&slots_offset, data + 32, sizeof(slots_offset));
+    std::memcpy(&slot_count, data + 40, sizeof(slot_count));
+    for (uint32_t i = 0; i < slot_count; ++i) {
+        const uint32_t clip = 5000;
+        std::memcpy(data + slots_offset + i * 8 + 4, &clip, sizeof(clip));
+    }
+    assert(file.OpenMemory(damaged.data(), serialized.size()));
+    assert(-1 == file.FindClip("clip_7"));
+    file.Close();
+    assert(-1 == file.FindClip("clip_7"));
+}
+
+static void TestMapsFile() {
+    const char *path = "baked_clip_test.ccac";
+    ClipWriter writer;
+    assert(writer.AddClip("fade", FadeKeyframes(), std::chrono::milliseconds(400)));
+    assert(writer.Write(path));
+    {
+        ClipFile file;
+        assert(file.Open(path));
+        BakedClip<float> fade;
+        assert(file.GetClip("fade", &fade));
+        assert(std::chrono::milliseconds(400) == fade.duration);
+        ValueAnimation<float> fade_expected(FadeKeyframes()), fade_baked(fade);
+        fade_expected.SetDuration(400);
+        ExpectSameValues(fade_expected, fade_baked);
+    }
+    std::remove(path);
+    ClipFile missing;
+    assert(!missing.Open(path));
+}
+
+static void TestDecodesCurvesOnce() {
+    const std::vector<Block> blocks = ToBlocks(BakeClips());
+    ClipFile file;
+    assert(file.OpenMemory(blocks.data(), blocks.size() * sizeof(Block)));
+    BakedClip<float> fade;
+    assert(file.GetClip("fade", &fade));
+    ValueAnimation<float> expected(FadeKeyframes()), baked(fade), other(fade);
+    expected.SetDuration(400);
+    // Animations of the clip decode its curves on several threads at once, all get the same ones
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            ValueAnimation<float> &animation = (t & 1) ? baked : other;
+            for (long msecs = t; msecs <= 400; msecs += 9) {
+                assert(expected.Evaluate(msecs) == animation.Evaluate(msecs));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    assert(fade.index->curves() == fade.index->curves());
+}
+
+int main() {
+    TestEvaluatesInPlace();
+    TestRejectsDamagedFiles();
+    TestFindsEveryName();
+    TestMapsFile();
+    TestDecodesCurvesOnce();
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <cassert>
+#include <memory>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_change_log.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::AnimationDriver;
+using anim::ChangeLog;
+using anim::ValueAnimation;
+
+static void TestFrameEntries() {
+    AnimationDriver driver;
+    ChangeLog<float> log;
+    driver.AddChangeLog(&log);
+
+    ValueAnimation<float> moving(0.0f, 10.0f), still(5.0f, 5.0f);
+    moving.set_change_log(&log, 7);
+    still.set_change_log(&log, 9);
+    for (auto animation : {&moving, &still}) {
+        animation->set_driver(&driver);
+        animation->SetDuration(100);
+        animation->Start();
+    }
+    // The start values, a still animation reports its first value once
+    assert(2 == log.size());
+    assert(7 == log[0].id && 0.0f == log[0].value);
+    assert(9 == log[1].id && 5.0f == log[1].value);
+
+    // Frame 0 changes nothing
+    driver.Tick(0);
+    assert(log.empty());
+    for (long time = 10; !driver.IsIdle(); time += 10) {
+        driver.Tick(time);
+        assert(1 == log.size());
+        assert(7 == log.data()[0].id && moving.current_value() == log.data()[0].value);
+    }
+    assert(10.0f == log[0].value);
+
+    // Restarting reports the first value again, though it equals the last one
+    driver.Tick(1000);
+    still.Start();
+    assert(1 == log.size() && 9 == log[0].id);
+
+    driver.RemoveChangeLog(&log);
+    driver.Tick(2000);
+    assert(1 == log.size());
+}
+
+static std::vector<ChangeLog<float>::Entry> Record(int thread_count) {
+    AnimationDriver driver;
+    driver.set_thread_count(thread_count);
+    driver.set_chunk_size(8);
+    ChangeLog<float> log;
+    driver.AddChangeLog(&log);
+    std::vector<std::unique_ptr<ValueAnimation<float>>> animations;
+    for (uint32_t i = 0; i < 100; ++i) {
+        // Every third animation holds its value
+        animations.emplace_back(new ValueAnimation<float>(float(i), float(i % 3 ? i + 1 : i)));
+        animations.back()->set_driver(&driver);
+        animations.back()->SetDuration(50 + 10 * (i % 5));
+        animations.back()->set_change_log(&log, i);
+        animations.back()->Start();
+    }
+    std::vector<ChangeLog<float>::Entry> entries;
+    for (long time = 0; !driver.IsIdle(); time += 16) {
+        driver.Tick(time);
+        entries.insert(entries.end(), log.begin(), log.end());
+    }
+    return entries;
+}
+
+int main() {
+    TestFrameEntries();
+    // A parallel tick logs the same entries in the same order
+    const auto serial = Record(1);
+    const auto parallel = Record(3);
+    assert(!serial.empty() && serial.size() == parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        assert(serial[i].id == parallel[i].id && serial[i].value == parallel[i].value);
+        assert(serial[i].id % 3 != 0);
+    }
+    return 0;
+}
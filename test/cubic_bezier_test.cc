@@ -0,0 +1,99 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "cc_easing_curve.hpp"
+
+using anim::CurveType;
+using anim::EasingCurve;
+
+// Solves x(t) = progress by bisection in long double, then evaluates y(t)
+static long double ReferenceBezier(const float points[4], long double progress) {
+    const long double x1 = points[0], y1 = points[1], x2 = points[2], y2 = points[3];
+    auto bezier = [](long double p1, long double p2, long double t) {
+        const long double u = 1.0L - t;
+        return 3.0L * u * u * t * p1 + 3.0L * u * t * t * p2 + t * t * t;
+    };
+    long double low = 0.0L;
+    long double high = 1.0L;
+    for (int i = 0; i < 200; ++i) {
+        const long double t = 0.5L * (low + high);
+        if (bezier(x1, x2, t) < progress) low = t;
+        else high = t;
+    }
+    return bezier(y1, y2, 0.5L * (low + high));
+}
+
+int main() {
+    // The error grows with the slope dy/dx, as t is only solved to float precision
+    const struct {
+        float points[4];
+        float max_error;
+    } curves[] = {
+        {{0.25f, 0.1f, 0.25f, 1.0f}, 1e-6f},     // ease
+        {{0.42f, 0.0f, 1.0f, 1.0f}, 1e-6f},      // ease-in
+        {{0.0f, 0.0f, 0.58f, 1.0f}, 1e-6f},      // ease-out
+        {{0.42f, 0.0f, 0.58f, 1.0f}, 1e-6f},     // ease-in-out
+        {{0.0f, 0.0f, 1.0f, 1.0f}, 1e-6f},       // linear
+        {{0.4f, 0.0f, 0.2f, 1.0f}, 1e-6f},       // Material standard
+        {{0.68f, -0.55f, 0.265f, 1.55f}, 1e-6f}, // overshooting both ends
+        {{0.9f, 0.0f, 0.1f, 1.0f}, 2e-6f},       // steep in the middle
+        {{0.0f, 1.0f, 1.0f, 0.0f}, 1e-5f},       // vertical at both ends, flat in the middle
+    };
+    const int count = 4097;
+    std::vector<float> progress(count);
+    std::vector<float> values(count);
+    for (int i = 0; i < count; ++i) {
+        progress[i] = float(i) / float(count - 1);
+    }
+
+    float max_error = 0.0f;
+    for (const auto &reference : curves) {
+        const float *points = reference.points;
+        for (bool sample_table : {false, true}) {
+            const EasingCurve curve = EasingCurve::Bezier(points[0], points[1], points[2], points[3], sample_table);
+            assert(curve.type() == CurveType::CubicBezier);
+            assert(curve.IsValid());
+            float control_points[4];
+            assert(curve.GetControlPoints(control_points));
+            for (int i = 0; i < 4; ++i) {
+                assert(std::fabs(control_points[i] - points[i]) < 1e-6f);
+            }
+            assert(curve.ValueForProgress(0.0f) == 0.0f);
+            assert(curve.ValueForProgress(1.0f) == 1.0f);
+
+            curve.ValuesForProgress(progress.data(), values.data(), count);
+            for (int i = 0; i < count; ++i) {
+                assert(values[i] == curve.ValueForProgress(progress[i]));
+                const float error = float(std::fabs(values[i] - ReferenceBezier(points, progress[i])));
+                assert(error <= reference.max_error);
+                if (error > max_error) max_error = error;
+            }
+        }
+    }
+    printf("cubic bezier max error %g\n", max_error);
+
+    // The CSS "ease" curve by default
+    float points[4];
+    assert(EasingCurve(CurveType::CubicBezier).GetControlPoints(points));
+    assert(points[0] == 0.25f && points[3] == 1.0f);
+    assert(!EasingCurve(CurveType::InQuad).GetControlPoints(points));
+
+    // x is clamped to [0, 1], outside of [0, 1] progress follows the end tangents
+    const EasingCurve clamped = EasingCurve::Bezier(-1.0f, 0.0f, 2.0f, 1.0f);
+    assert(clamped.GetControlPoints(points) && points[0] == 0.0f && std::fabs(points[2] - 1.0f) < 1e-6f);
+    const EasingCurve ease_out = EasingCurve::Bezier(0.5f, 1.0f, 0.5f, 1.0f);
+    assert(std::fabs(ease_out.ValueForProgress(-0.25f) - -0.5f) < 1e-6f);
+    assert(std::fabs(ease_out.ValueForProgress(1.5f) - 1.0f) < 1e-6f);
+
+    // Parameters are the bezier coefficients, the setters leave them alone
+    EasingCurve ease = EasingCurve::Bezier(0.25f, 0.1f, 0.25f, 1.0f);
+    const float half = ease.ValueForProgress(0.5f);
+    ease.set_amplitude(3.0f);
+    assert(ease.ValueForProgress(0.5f) == half);
+
+    const EasingCurve baked = ease.Baked(1024);
+    assert(baked.IsBaked() && baked.baked_max_error() < 1e-4f);
+    assert(std::fabs(baked.ValueForProgress(0.5f) - half) < 1e-4f);
+    return 0;
+}
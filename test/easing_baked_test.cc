@@ -0,0 +1,129 @@
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include "cc_easing_curve.hpp"
+
+using anim::CurveType;
+using anim::EasingCurve;
+
+static size_t g_allocations = 0;
+
+void *operator new(size_t size) {
+    ++g_allocations;
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static float Steep(float t) { return t * t * t * t; }
+
+// Largest difference to the analytic curve between the samples of a table of the given resolution
+static float MeasureError(const EasingCurve &baked, const EasingCurve &curve, int resolution) {
+    float max_error = 0.0f;
+    const int count = resolution * 7;
+    for (int i = 0; i <= count; ++i) {
+        const float progress = float(i) / float(count);
+        max_error = std::fmax(max_error, std::fabs(baked.ValueForProgress(progress) - curve.ValueForProgress(progress)));
+    }
+    return max_error;
+}
+
+static void TestSharedTables() {
+    const EasingCurve curve(CurveType::OutCubic);
+    const EasingCurve first = curve.Baked(128);
+    size_t allocations = g_allocations;
+    // An equal curve finds the table built for the first one
+    const EasingCurve second = EasingCurve(CurveType::OutCubic).Baked(128);
+    assert(allocations == g_allocations);
+    assert(second.IsBaked() && first.baked_max_error() == second.baked_max_error());
+    for (float t = 0.0f; t <= 1.0f; t += 0.01f) {
+        assert(first.ValueForProgress(t) == second.ValueForProgress(t));
+    }
+    // So does baking a baked curve again, from the curve it was baked from
+    assert(first.baked_max_error() == first.Baked(128).baked_max_error());
+    assert(allocations == g_allocations);
+
+    // Another resolution or another function is another table
+    const EasingCurve finer = curve.Baked(1024);
+    assert(allocations != g_allocations);
+    assert(finer.baked_max_error() < first.baked_max_error());
+    allocations = g_allocations;
+    const EasingCurve steep = EasingCurve(&Steep).Baked(128);
+    assert(allocations != g_allocations);
+    assert(std::fabs(steep.ValueForProgress(0.5f) - Steep(0.5f)) <= steep.baked_max_error());
+}
+
+static void TestClamping() {
+    // Back overshoots outside of [0, 1], its baked version holds the end values
+    const EasingCurve curve(CurveType::InOutBack);
+    const EasingCurve baked = curve.Baked();
+    assert(curve.ValueForProgress(-0.5f) != curve.ValueForProgress(0.0f));
+    assert(baked.ValueForProgress(-0.5f) == baked.ValueForProgress(0.0f));
+    assert(baked.ValueForProgress(1.5f) == baked.ValueForProgress(1.0f));
+    assert(0.0f == baked.ValueForProgress(-100.0f) && 1.0f == baked.ValueForProgress(100.0f));
+
+    float progress[4] = {-1.0f, 0.0f, 1.0f, 2.0f};
+    baked.ValuesForProgress(progress, progress, 4);
+    assert(progress[0] == progress[1] && progress[2] == progress[3]);
+}
+
+static void TestMaxError() {
+    // At the default resolution. Smooth curves are within 2.5e-4, those with kinks, jumps or
+    // infinite slopes (Expo, Circ, Elastic and Bounce) within a few percent
+    for (int i = 0; i <= int(CurveType::CosineCurve); ++i) {
+        const CurveType type = static_cast<CurveType>(i);
+        const EasingCurve curve(type);
+        const EasingCurve baked = curve.Baked();
+        const bool smooth = (type < CurveType::InExpo) || (type >= CurveType::InBack && type <= CurveType::OutInBack)
+            || type >= CurveType::InCurve;
+        assert(baked.baked_max_error() <= (smooth ? 2.5e-4f : 0.025f));
+        // A finer table is never worse
+        assert(curve.Baked(1024).baked_max_error() <= baked.baked_max_error());
+        // The reported error holds between the samples, measured elsewhere than where it was
+        if (smooth) {
+            assert(MeasureError(baked, curve, 256) <= baked.baked_max_error() * 1.01f + 1e-6f);
+        }
+    }
+    assert(0.0f == EasingCurve(CurveType::Linear).Baked().baked_max_error());
+    assert(0.0f == EasingCurve(CurveType::OutQuad).baked_max_error());
+}
+
+static void TestParameterChange() {
+    const EasingCurve baked = EasingCurve(CurveType::OutElastic).Baked();
+    EasingCurve changed = baked;
+    changed.set_amplitude(1.5f);
+    // The old table was sampled with the old amplitude
+    assert(!changed.IsBaked() && 0.0f == changed.baked_max_error());
+    EasingCurve analytic(CurveType::OutElastic);
+    analytic.set_amplitude(1.5f);
+    assert(changed.ValueForProgress(0.1f) == analytic.ValueForProgress(0.1f));
+
+    const EasingCurve rebaked = changed.Baked();
+    assert(rebaked.IsBaked());
+    assert(std::fabs(rebaked.ValueForProgress(0.1f) - analytic.ValueForProgress(0.1f)) <= rebaked.baked_max_error());
+    assert(std::fabs(rebaked.ValueForProgress(0.1f) - baked.ValueForProgress(0.1f)) > 0.01f);
+    // The original keeps its own table
+    assert(std::fabs(baked.ValueForProgress(0.1f) - EasingCurve(CurveType::OutElastic).ValueForProgress(0.1f))
+           <= baked.baked_max_error());
+
+    // A Custom curve gets its function back
+    EasingCurve custom = EasingCurve(&Steep).Baked(4);
+    assert(custom.ValueForProgress(0.3f) != Steep(0.3f));
+    custom.set_overshoot(2.0f);
+    assert(!custom.IsBaked() && Steep(0.3f) == custom.ValueForProgress(0.3f));
+
+    // Bezier coefficients are not parameters, a baked bezier stays baked
+    EasingCurve bezier = EasingCurve::Bezier(0.42f, 0.0f, 0.58f, 1.0f, true).Baked();
+    bezier.set_amplitude(3.0f);
+    assert(bezier.IsBaked());
+}
+
+int main() {
+    TestSharedTables();
+    TestClamping();
+    TestMaxError();
+    TestParameterChange();
+    return 0;
+}
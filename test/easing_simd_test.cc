@@ -0,0 +1,50 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "cc_easing_curve.hpp"
+
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::SimdLevel;
+
+int main() {
+    const SimdLevel detected = EasingCurve::simd_level();
+    // Odd count, so the padded tail of every vector width gets exercised too
+    const size_t count = 4099;
+    std::vector<float> progress(count);
+    for (size_t i = 0; i < count; ++i) {
+        progress[i] = float(i) / float(count - 1);
+    }
+    std::vector<float> values(count);
+
+    for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse2, SimdLevel::kAvx2, SimdLevel::kNeon}) {
+        if (!EasingCurve::SetSimdLevel(level)) continue;
+        assert(EasingCurve::simd_level() == level);
+        float level_max_error = 0.0f;
+        for (int type = 0; type < anim::kCurveTypeCount; ++type) {
+            // Default parameters, then parameters hitting the other branches of Elastic
+            for (float scale : {1.0f, 0.25f, 1.5f}) {
+                EasingCurve curve{CurveType(type)};
+                curve.set_amplitude(scale);
+                curve.set_period(scale * 0.3f);
+                curve.set_overshoot(scale * 1.70158f);
+                curve.ValuesForProgress(progress.data(), values.data(), count);
+                float max_error = 0.0f;
+                for (size_t i = 0; i < count; ++i) {
+                    const float error = std::fabs(values[i] - curve.ValueForProgress(progress[i]));
+                    if (error > max_error) max_error = error;
+                }
+                if (max_error > level_max_error) level_max_error = max_error;
+                if (SimdLevel::kScalar == level) {
+                    assert(max_error == 0.0f);
+                } else {
+                    assert(max_error <= EasingCurve::kSimdMaxError);
+                }
+            }
+        }
+        printf("simd level %d: max error %.3g\n", int(level), level_max_error);
+    }
+    EasingCurve::SetSimdLevel(detected);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <cassert>
+#include <thread>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::ValueAnimation;
+
+static const long kFrameInterval = 7L;
+
+static std::vector<Keyframe<float>> MakeKeyframes() {
+    return {Keyframe<float>(0.0f, 0.0f, EasingCurve(CurveType::OutBack)),
+            Keyframe<float>(0.3f, 4.0f), Keyframe<float>(0.6f, -2.0f, EasingCurve(CurveType::InCubic)),
+            Keyframe<float>(1.0f, 10.0f)};
+}
+
+// Every frame of a driven run shows the value Evaluate() gives for its elapsed time
+static void ExpectEvaluateMatchesPlayback(Animation::Direction direction, int loop_count, Animation::LoopMode mode) {
+    AnimationDriver driver;
+    ValueAnimation<float> animation(MakeKeyframes());
+    animation.set_driver(&driver);
+    animation.SetDuration(100);
+    animation.set_direction(direction);
+    animation.set_loop_count(loop_count);
+    animation.set_loop_mode(mode);
+    animation.Start();
+    assert(animation.Evaluate(0L) == animation.current_value());
+    const long start = 1000;
+    for (long time = start; Animation::State::kRunning == animation.state(); time += kFrameInterval) {
+        driver.Tick(time);
+        assert(animation.Evaluate(time - start) == animation.current_value());
+    }
+    // Past the end it holds the last value
+    assert(animation.Evaluate(100000L) == animation.current_value());
+}
+
+static void TestLoopModes() {
+    for (auto direction : {Animation::Direction::kForward, Animation::Direction::kReverse}) {
+        for (int loop_count : {1, 3}) {
+            for (auto mode : {Animation::LoopMode::kRestart, Animation::LoopMode::kReverse}) {
+                ExpectEvaluateMatchesPlayback(direction, loop_count, mode);
+            }
+        }
+    }
+
+    ValueAnimation<float> animation(0.0f, 10.0f);
+    animation.SetDuration(100);
+    animation.set_easing_curve(EasingCurve(CurveType::Linear));
+    animation.set_loop_count(3);
+    assert(5.0f == animation.Evaluate(150L));
+    animation.set_loop_mode(Animation::LoopMode::kReverse);
+    // Back and forth
+    assert(7.5f == animation.Evaluate(125L));
+    assert(2.5f == animation.Evaluate(225L));
+    assert(10.0f == animation.Evaluate(300L));
+    animation.set_direction(Animation::Direction::kReverse);
+    assert(0.0f == animation.Evaluate(300L));
+}
+
+static void TestNoSideEffects() {
+    ValueAnimation<float> animation(MakeKeyframes());
+    int notified = 0;
+    animation.subscriber_ = [&notified](const float &) { ++notified; };
+    animation.SetDuration(100);
+    for (long time = 0; time <= 100; time += 5) {
+        animation.Evaluate(time);
+    }
+    assert(0 == notified);
+    assert(Animation::State::kStopped == animation.state());
+    assert(0.0f == animation.current_value() && 0 == animation.GetCurrentTime());
+}
+
+// Threads sample one animation while its driver ticks it, build with CC_ANIMATION_TSAN to check
+static void TestConcurrentSampling() {
+    AnimationDriver driver;
+    ValueAnimation<float> animation(MakeKeyframes());
+    animation.set_driver(&driver);
+    animation.SetDuration(1000);
+    animation.set_loop_count(2);
+    animation.set_loop_mode(Animation::LoopMode::kReverse);
+
+    std::vector<float> expected;
+    for (long time = 0; time <= 2000; time += 3) {
+        expected.push_back(animation.Evaluate(time));
+    }
+    animation.Start();
+    std::vector<std::thread> threads;
+    std::vector<char> matched(4, 0);
+    for (size_t t = 0; t < matched.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            bool same = true;
+            for (size_t i = 0; i < expected.size(); ++i) {
+                same = same && expected[i] == animation.Evaluate(long(i) * 3);
+            }
+            matched[t] = same;
+        });
+    }
+    for (long time = 0; time <= 2000; time += 16) {
+        driver.Tick(time);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (char same : matched) {
+        assert(same);
+    }
+}
+
+int main() {
+    TestLoopModes();
+    TestNoSideEffects();
+    TestConcurrentSampling();
+    return 0;
+}
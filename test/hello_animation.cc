@@ -1,5 +1,7 @@
+#include <cassert>
 #include <chrono>
 #include <thread>
+#include "cc_animation_driver.hpp"
 #include "cc_value_animation.hpp"
 #include <iostream>
 class A {
@@ -30,11 +32,16 @@ int main() {
     anim1.subscriber_= (std::bind(&A::set_prop, &a, std::placeholders::_1));
     anim1.Start();
     assert(anim1.state() == anim::Animation::State::kRunning);
-    while (anim1.state() != anim::Animation::State::kStopped) {
-        auto ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
-        anim1.UpdateAnimationFrame(ms.count());
-        std::this_thread::sleep_for(milliseconds(10));
+    auto &driver = anim::AnimationDriver::GetInstance();
+    assert(driver.animation_count() == 1);
+    while (!driver.IsIdle()) {
+        driver.Tick();
+        // Sleeps until the next frame rather than polling, the deadline is Duration::max() once idle
+        const anim::Duration deadline = driver.NextDeadline();
+        if (anim::Duration::max() == deadline) break;
+        std::this_thread::sleep_until(steady_clock::time_point(duration_cast<steady_clock::duration>(deadline)));
     }
+    assert(anim1.state() == anim::Animation::State::kStopped);
     anim::ValueAnimation<float> anim2({anim::Keyframe<float>(1.0f, 100), anim::Keyframe<float>(0.0f, 0)});
     anim::ValueAnimation<double> anim3({1, 3, 5, 7, 9});
     // anim::ValueAnimation<A> anim4(A(0), A(1));
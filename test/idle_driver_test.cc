@@ -0,0 +1,127 @@
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_timer.hpp"
+#include "cc_value_animation.hpp"
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::Duration;
+using anim::ValueAnimation;
+using std::chrono::milliseconds;
+
+static void TestDeadlines() {
+    AnimationDriver driver;
+    int wakeups = 0;
+    driver.set_wakeup_callback([&wakeups] { ++wakeups; });
+    assert(Duration::max() == driver.NextDeadline());
+
+    ValueAnimation<float> delayed(0.0f, 1.0f), other(0.0f, 1.0f);
+    for (auto animation : {&delayed, &other}) {
+        animation->set_driver(&driver);
+        animation->SetDuration(200);
+        animation->set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+    }
+    delayed.set_start_delay(milliseconds(500));
+    float value = -1.0f;
+    delayed.subscriber_ = [&value](const float &v) { value = v; };
+    delayed.Start();
+    assert(1 == wakeups);
+    assert(0.0f == value);
+    // Not ticked yet, the delay starts with the first frame
+    assert(Duration::min() == driver.NextDeadline());
+
+    const Duration origin = milliseconds(10000);
+    driver.Tick(origin);
+    assert(origin + milliseconds(500) == driver.NextDeadline());
+    driver.Tick(origin + milliseconds(300));
+    assert(0.0f == value && Duration::zero() == delayed.current_time());
+
+    // A running animation needs the next frame
+    other.Start();
+    assert(2 == wakeups);
+    driver.Tick(origin + milliseconds(310));
+    assert(origin + milliseconds(310) + driver.frame_interval() == driver.NextDeadline());
+    other.Stop();
+    assert(origin + milliseconds(500) == driver.NextDeadline());
+
+    driver.Tick(origin + milliseconds(600));
+    assert(milliseconds(100) == delayed.current_time());
+    assert(0.5f == value);
+
+    // Resuming does not delay again
+    delayed.Pause();
+    assert(Duration::max() == driver.NextDeadline());
+    delayed.Resume();
+    driver.Tick(origin + milliseconds(2000));
+    driver.Tick(origin + milliseconds(2050));
+    assert(milliseconds(150) == delayed.current_time());
+
+    driver.Post(&delayed, AnimationDriver::Command::kCancel);
+    assert(Duration::min() == driver.NextDeadline());
+    const int posted_wakeups = wakeups;
+    driver.Tick(origin + milliseconds(2060));
+    assert(posted_wakeups > 2 && driver.IsIdle());
+    assert(Duration::max() == driver.NextDeadline());
+}
+
+#if defined(__linux__)
+// Waits for the timer, returns false on timeout
+static bool Wait(int epoll_fd, anim::AnimationTimer &timer, int timeout_ms) {
+    epoll_event event;
+    const int count = epoll_wait(epoll_fd, &event, 1, timeout_ms);
+    if (count <= 0) return false;
+    timer.OnReadable();
+    return true;
+}
+
+static void TestTimer() {
+    AnimationDriver driver;
+    driver.set_frame_interval(milliseconds(5));
+    anim::AnimationTimer timer(&driver);
+    assert(timer.IsValid());
+    const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer.fd(), &event);
+
+    // Idle, nothing wakes the loop
+    assert(!Wait(epoll_fd, timer, 50));
+
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    animation.set_driver(&driver);
+    animation.SetDuration(60);
+    animation.Start();
+    int ticks = 0;
+    while (!driver.IsIdle()) {
+        assert(Wait(epoll_fd, timer, 1000));
+        ++ticks;
+    }
+    assert(Animation::State::kStopped == animation.state());
+    assert(ticks >= 2);
+    assert(!Wait(epoll_fd, timer, 50));
+
+    // A command posted by another thread wakes the loop
+    std::thread producer([&] { driver.Post(&animation, AnimationDriver::Command::kStart); });
+    assert(Wait(epoll_fd, timer, 1000));
+    producer.join();
+    assert(Animation::State::kRunning == animation.state());
+    animation.Cancel();
+    timer.Arm();
+    assert(!Wait(epoll_fd, timer, 50));
+    close(epoll_fd);
+}
+#endif
+
+int main() {
+    TestDeadlines();
+#if defined(__linux__)
+    TestTimer();
+#endif
+    return 0;
+}
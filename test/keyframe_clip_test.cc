@@ -0,0 +1,104 @@
+#include <cassert>
+#include <memory>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_clip_player.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::AnimationDriver;
+using anim::ClipPlayer;
+using anim::ClipRef;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::KeyframeClip;
+using anim::ValueAnimation;
+
+static std::vector<Keyframe<float>> MakeKeyframes() {
+    std::vector<Keyframe<float>> keyframes;
+    // Enough keyframes for a bucket index, unsorted
+    for (int i = 20; i >= 0; --i) {
+        keyframes.push_back(Keyframe<float>(i / 20.0f, float(i * 3 % 7), EasingCurve(CurveType(i % 8))));
+    }
+    return keyframes;
+}
+
+static void TestReferenceCount() {
+    ClipRef<float> clip = KeyframeClip<float>::Create({{0.0f, 0.0f}, {1.0f, 1.0f}});
+    assert(1 == clip->ref_count());
+    {
+        ClipRef<float> copy = clip;
+        ValueAnimation<float> animation(clip);
+        ClipPlayer<float> player(clip);
+        assert(4 == clip->ref_count());
+        assert(animation.shared_clip().get() == clip.get());
+        // Shared, not copied
+        assert(&animation.keyframes() == &clip->keyframes());
+        ClipRef<float> moved = std::move(copy);
+        assert(!copy && 4 == clip->ref_count());
+    }
+    assert(1 == clip->ref_count());
+    ClipRef<float> other;
+    other = clip;
+    clip = ClipRef<float>();
+    assert(!clip && 1 == other->ref_count());
+}
+
+static void TestSharedValues() {
+    const ClipRef<float> clip = KeyframeClip<float>::Create(MakeKeyframes(), std::chrono::milliseconds(500),
+                                                            EasingCurve(CurveType::OutCubic));
+    AnimationDriver driver;
+    // The same track owned by the animation, and shared
+    ValueAnimation<float> owned(MakeKeyframes()), shared(clip);
+    owned.SetDuration(500);
+    owned.set_easing_curve(EasingCurve(CurveType::OutCubic));
+    assert(owned.duration() == shared.duration());
+    std::vector<ClipPlayer<float>> players(3, ClipPlayer<float>(clip));
+    for (auto animation : {&owned, &shared}) {
+        animation->set_driver(&driver);
+        animation->Start();
+    }
+    for (auto &player : players) {
+        player.Start();
+    }
+    driver.Tick(0L);
+    for (long time = 0; !driver.IsIdle(); time += 16) {
+        driver.Tick(time);
+        assert(owned.current_value() == shared.current_value());
+        for (auto &player : players) {
+            if (time > 0) player.Advance(std::chrono::milliseconds(16));
+            assert(shared.current_value() == player.value());
+        }
+    }
+    for (auto &player : players) {
+        assert(!player.IsRunning() && clip->duration() == player.current_time());
+    }
+    // Seeking back uses the index
+    players[0].SetCurrentTime(std::chrono::milliseconds(100));
+    shared.SetCurrentTime(100);
+    assert(shared.current_value() == players[0].value());
+}
+
+static void TestPlayerWithoutClip() {
+    ClipPlayer<float> player;
+    player.Start();
+    assert(!player.IsRunning());
+    assert(!player.Advance(std::chrono::milliseconds(16)));
+    player.SetCurrentTime(std::chrono::milliseconds(100));
+    assert(anim::Duration::zero() == player.current_time() && 0.0f == player.value());
+
+    // Plays once given a clip
+    player.set_clip(KeyframeClip<float>::Create({{0.0f, 0.0f}, {1.0f, 4.0f}}, std::chrono::milliseconds(100),
+                                                EasingCurve(CurveType::Linear)));
+    player.Start();
+    assert(player.Advance(std::chrono::milliseconds(50)) && 2.0f == player.value());
+    player.set_clip(ClipRef<float>());
+    assert(!player.IsRunning() && !player.Advance(std::chrono::milliseconds(50)));
+}
+
+int main() {
+    TestReferenceCount();
+    TestSharedValues();
+    TestPlayerWithoutClip();
+    return 0;
+}
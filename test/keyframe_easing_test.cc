@@ -0,0 +1,43 @@
+#include <cassert>
+#include <cmath>
+#include "cc_value_animation.hpp"
+
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+using anim::StaticCurve;
+using anim::ValueAnimation;
+
+int main() {
+    // Three segments: linear, InQuad then OutCubic
+    ValueAnimation<float, StaticCurve<CurveType::Linear>> animation({
+        Keyframe<float>(0.0f, 0.0f),
+        Keyframe<float>(0.25f, 100.0f, EasingCurve(CurveType::InQuad)),
+        Keyframe<float>(0.5f, 200.0f, EasingCurve(CurveType::OutCubic)),
+        Keyframe<float>(1.0f, 400.0f),
+    });
+    animation.SetDuration(1000L);
+    float value = 0.0f;
+    animation.subscriber_ = [&value](const float &v) { value = v; };
+
+    const EasingCurve in_quad(CurveType::InQuad);
+    const EasingCurve out_cubic(CurveType::OutCubic);
+    for (long time = 0; time <= 1000L; time += 5) {
+        animation.SetCurrentTime(time);
+        const float progress = float(time) / 1000.0f;
+        float expected;
+        if (progress <= 0.25f) {
+            expected = 100.0f * progress / 0.25f;
+        } else if (progress <= 0.5f) {
+            expected = 100.0f + 100.0f * in_quad.ValueForProgress((progress - 0.25f) / 0.25f);
+        } else {
+            expected = 200.0f + 200.0f * out_cubic.ValueForProgress((progress - 0.5f) / 0.5f);
+        }
+        assert(std::fabs(value - expected) < 1e-3f);
+    }
+
+    // Seeking back into an eased segment picks its curve up again
+    animation.SetCurrentTime(375L);
+    assert(std::fabs(value - (100.0f + 100.0f * in_quad.ValueForProgress(0.5f))) < 1e-3f);
+    return 0;
+}
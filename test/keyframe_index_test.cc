@@ -0,0 +1,90 @@
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include "cc_keyframe.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Keyframe;
+using anim::KeyframeIndex;
+using anim::ValueAnimation;
+
+// The interval the keyframe index must find, by a linear search
+static size_t ExpectedInterval(const std::vector<Keyframe<float>> &keyframes, float progress) {
+    size_t i = 0;
+    while (i + 2 < keyframes.size() && progress > keyframes[i + 1].progress()) ++i;
+    return i;
+}
+
+static void CheckIndex(const std::vector<Keyframe<float>> &keyframes) {
+    KeyframeIndex index;
+    index.Build(keyframes);
+    size_t hint = 0;
+    // Sequential, forward then backward, going out of range on both sides
+    for (int i = -100; i <= 1100; ++i) {
+        const float progress = float(i) / 1000.0f;
+        hint = index.Find(keyframes, progress, hint);
+        assert(hint == ExpectedInterval(keyframes, progress));
+    }
+    for (int i = 1100; i >= -100; --i) {
+        const float progress = float(i) / 1000.0f;
+        hint = index.Find(keyframes, progress, hint);
+        assert(hint == ExpectedInterval(keyframes, progress));
+    }
+    // Random seeks, also exactly on the keyframes
+    srand(7);
+    for (int i = 0; i < 5000; ++i) {
+        const float progress = (i % 2)
+            ? keyframes[rand() % keyframes.size()].progress()
+            : float(rand() % 12001 - 1000) / 10000.0f;
+        hint = index.Find(keyframes, progress, hint);
+        assert(hint == ExpectedInterval(keyframes, progress));
+        // A hint past the end means none
+        assert(index.Find(keyframes, progress, keyframes.size()) == hint);
+    }
+    // Progress a Custom curve may return, far out of the range or not a number
+    const size_t last = keyframes.size() - 2;
+    for (float progress : {1e30f, std::numeric_limits<float>::infinity(), -1e30f,
+                           -std::numeric_limits<float>::infinity()}) {
+        assert(index.Find(keyframes, progress, 0) == (progress > 0.0f ? last : 0));
+        assert(index.Find(keyframes, progress, last) == (progress > 0.0f ? last : 0));
+    }
+    const size_t nan = index.Find(keyframes, std::numeric_limits<float>::quiet_NaN(), last / 2);
+    assert(nan <= last);
+}
+
+int main() {
+    for (size_t count : {2, 3, 15, 16, 17, 500, 5000}) {
+        // Uniform
+        std::vector<Keyframe<float>> keyframes;
+        for (size_t i = 0; i < count; ++i) {
+            keyframes.emplace_back(float(i) / float(count - 1), float(i));
+        }
+        CheckIndex(keyframes);
+
+        // Crowded at the start, with duplicates
+        keyframes.clear();
+        for (size_t i = 0; i < count; ++i) {
+            const float x = float(i / 2 * 2) / float(count - 1);
+            keyframes.emplace_back(x * x * x, float(i));
+        }
+        keyframes.back().set_progress(1.0f);
+        CheckIndex(keyframes);
+    }
+
+    // A long track, scrubbed back and forth
+    std::vector<Keyframe<float>> keyframes;
+    for (int i = 0; i < 1000; ++i) {
+        keyframes.emplace_back(float(i) / 999.0f, float((i * 37) % 101));
+    }
+    ValueAnimation<float, anim::StaticCurve<anim::CurveType::Linear>> track(keyframes);
+    track.SetDuration(999L * 4);
+    float value = -1.0f;
+    track.subscriber_ = [&value](const float &v) { value = v; };
+    for (long time : {0L, 4L, 8L, 3996L, 2000L, 2004L, 1000L, 12L}) {
+        track.SetCurrentTime(time);
+        // Every 4 ms is a keyframe
+        assert(value == keyframes[time / 4].value() || (0L == time && -1.0f == value));
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <cassert>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_animation_set.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::AnimationListener;
+using anim::AnimationSet;
+using anim::Keyframe;
+using anim::ValueAnimation;
+
+struct Event
+{
+    int id;
+    float value;
+    std::thread::id thread;
+    bool operator==(const Event &other) const { return id == other.id && value == other.value; }
+};
+
+struct EndRecorder : AnimationListener
+{
+    std::vector<Event> *events;
+    int id;
+    void OnAnimationEnd(Animation &) override { events->push_back(Event{-id, 0.0f, std::this_thread::get_id()}); }
+};
+
+// Ticks the same set of animations with the given number of threads, recording every callback
+static std::vector<Event> Run(int thread_count) {
+    const int count = 3000;
+    AnimationDriver driver;
+    driver.set_thread_count(thread_count);
+    driver.set_chunk_size(64);
+    assert(driver.thread_count() == thread_count);
+
+    std::vector<Event> events;
+    std::vector<std::unique_ptr<ValueAnimation<float>>> animations;
+    std::vector<std::unique_ptr<EndRecorder>> recorders;
+    for (int i = 0; i < count; ++i) {
+        animations.emplace_back(new ValueAnimation<float>({
+            Keyframe<float>(0.0f, float(i) + 0.5f),
+            Keyframe<float>(0.5f, float(i) * 2.0f, anim::EasingCurve(anim::CurveType::OutBounce)),
+            Keyframe<float>(1.0f, -float(i)),
+        }));
+        ValueAnimation<float> &animation = *animations.back();
+        animation.set_driver(&driver);
+        animation.SetDuration(100L + 37L * (i % 11));
+        animation.set_loop_count(1 + i % 3);
+        animation.subscriber_ = [&events, i](const float &value) {
+            events.push_back(Event{i, value, std::this_thread::get_id()});
+        };
+        recorders.emplace_back(new EndRecorder);
+        recorders.back()->events = &events;
+        recorders.back()->id = i + 1;
+        animation.AddAnimationListener(recorders.back().get());
+    }
+    // A group counts as one animation
+    ValueAnimation<float> child_a(0.5f, 10.0f), child_b(10.0f, 0.5f);
+    child_a.subscriber_ = [&events](const float &value) { events.push_back(Event{count, value, std::this_thread::get_id()}); };
+    child_b.subscriber_ = [&events](const float &value) { events.push_back(Event{count + 1, value, std::this_thread::get_id()}); };
+    AnimationSet group(AnimationSet::Ordering::kSequential);
+    group.set_driver(&driver);
+    group.AddAnimation(&child_a);
+    group.AddAnimation(&child_b);
+
+    for (auto &animation : animations) animation->Start();
+    group.Start();
+    for (long time = 0; !driver.IsIdle(); time += 16) {
+        driver.Tick(time);
+    }
+    for (auto &animation : animations) assert(animation->state() == Animation::State::kStopped);
+    return events;
+}
+
+int main() {
+    const std::vector<Event> serial = Run(1);
+    assert(serial.size() > 3000);
+    for (int thread_count : {2, 4, 7}) {
+        const std::vector<Event> parallel = Run(thread_count);
+        // Same callbacks, in the same order, all on this thread
+        assert(parallel == serial);
+        for (const Event &event : parallel) {
+            assert(event.thread == std::this_thread::get_id());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Stress test of AnimationDriver::Post(), meant to also run under ThreadSanitizer:
+//   cmake -S . -B build-tsan -DCC_ANIMATION_TSAN=ON && cmake --build build-tsan && ctest --test-dir build-tsan
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::Animation;
+using anim::AnimationDriver;
+using anim::AnimationListener;
+using anim::ValueAnimation;
+
+// Only called on the ticking thread
+struct Counter : AnimationListener
+{
+    int starts = 0, pauses = 0, resumes = 0, cancels = 0, ends = 0;
+    void OnAnimationStart(Animation &) override { ++starts; }
+    void OnAnimationPause(Animation &) override { ++pauses; }
+    void OnAnimationResume(Animation &) override { ++resumes; }
+    void OnAnimationCancel(Animation &) override { ++cancels; }
+    void OnAnimationEnd(Animation &) override { ++ends; }
+};
+
+static void TestRunsInOrder() {
+    AnimationDriver driver;
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    animation.set_driver(&driver);
+    animation.SetDuration(1000);
+    Counter counter;
+    animation.AddAnimationListener(&counter);
+
+    driver.Post(&animation, AnimationDriver::Command::kStart);
+    driver.Post(&animation, AnimationDriver::Command::kPause);
+    // Nothing happens before the tick
+    assert(Animation::State::kStopped == animation.state());
+    driver.Tick(0);
+    assert(Animation::State::kPaused == animation.state());
+    assert(1 == counter.starts && 1 == counter.pauses);
+
+    driver.Post(&animation, AnimationDriver::Command::kResume);
+    driver.RunPostedCommands();
+    assert(Animation::State::kRunning == animation.state());
+    driver.Post(&animation, AnimationDriver::Command::kStop);
+    driver.Tick(10);
+    assert(Animation::State::kStopped == animation.state());
+    assert(1 == counter.ends && 0 == counter.cancels);
+    assert(driver.IsIdle());
+}
+
+// Sees the state of the animation before the tick runs the posted commands
+struct TickRecorder : anim::TickObserver
+{
+    const Animation *animation = nullptr;
+    std::vector<anim::Duration> frame_times;
+    std::vector<Animation::State> states;
+    std::vector<const Animation *> ended;
+    void OnTickBegin(anim::Duration frame_time) override {
+        frame_times.push_back(frame_time);
+        states.push_back(animation->state());
+    }
+    void OnAnimationEnd(Animation &ended_animation) override { ended.push_back(&ended_animation); }
+};
+
+static void TestTickObserverRunsFirst() {
+    AnimationDriver driver;
+    ValueAnimation<float> animation(0.0f, 1.0f);
+    animation.set_driver(&driver);
+    TickRecorder recorder;
+    recorder.animation = &animation;
+    driver.AddTickObserver(&recorder);
+    driver.AddTickObserver(&recorder);
+
+    driver.Post(&animation, AnimationDriver::Command::kStart);
+    driver.Tick(5);
+    driver.Tick(21);
+    driver.RemoveTickObserver(&recorder);
+    driver.Tick(37);
+    // Once per tick however often added, and no longer once removed
+    assert(2 == recorder.frame_times.size());
+    assert(std::chrono::milliseconds(5) == recorder.frame_times[0]);
+    assert(std::chrono::milliseconds(21) == recorder.frame_times[1]);
+    assert(Animation::State::kStopped == recorder.states[0] && Animation::State::kRunning == recorder.states[1]);
+
+    // Ends are reported too, without adding a listener to the animation
+    driver.AddTickObserver(&recorder);
+    animation.Stop();
+    recorder.ended.clear();
+    animation.SetDuration(20);
+    animation.Start();
+    driver.Tick(45);
+    driver.Tick(60);
+    assert(recorder.ended.empty());
+    driver.Tick(70);
+    assert(1 == recorder.ended.size() && &animation == recorder.ended[0]);
+    driver.RemoveTickObserver(&recorder);
+}
+
+static void TestManyProducers() {
+    const int kProducerCount = 4;
+    const int kAnimationsPerProducer = 50;
+    const int kRounds = 100;
+
+    AnimationDriver driver;
+    std::vector<std::unique_ptr<ValueAnimation<float>>> animations;
+    std::vector<Counter> counters(kProducerCount * kAnimationsPerProducer);
+    for (size_t i = 0; i < counters.size(); ++i) {
+        animations.emplace_back(new ValueAnimation<float>(0.0f, 1.0f));
+        animations.back()->set_driver(&driver);
+        animations.back()->SetDuration(100);
+        animations.back()->set_loop_count(Animation::INFINITE);
+        animations.back()->AddAnimationListener(&counters[i]);
+    }
+
+    std::atomic<int> finished(0);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducerCount; ++p) {
+        producers.emplace_back([&, p] {
+            // Each producer controls its own animations, so the commands of one animation keep their order
+            for (int a = 0; a < kAnimationsPerProducer; ++a) {
+                driver.Post(animations[p * kAnimationsPerProducer + a].get(), AnimationDriver::Command::kStart);
+            }
+            for (int round = 0; round < kRounds; ++round) {
+                for (int a = 0; a < kAnimationsPerProducer; ++a) {
+                    Animation *animation = animations[p * kAnimationsPerProducer + a].get();
+                    driver.Post(animation, AnimationDriver::Command::kPause);
+                    driver.Post(animation, AnimationDriver::Command::kResume);
+                }
+                if (0 == round % 10) std::this_thread::yield();
+            }
+            for (int a = 0; a < kAnimationsPerProducer; ++a) {
+                driver.Post(animations[p * kAnimationsPerProducer + a].get(), AnimationDriver::Command::kCancel);
+            }
+            finished.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    long time = 0;
+    while (finished.load(std::memory_order_acquire) < kProducerCount) {
+        driver.Tick(time);
+        time += 16;
+    }
+    for (auto &producer : producers) producer.join();
+    driver.Tick(time);
+
+    assert(driver.IsIdle());
+    for (size_t i = 0; i < counters.size(); ++i) {
+        assert(Animation::State::kStopped == animations[i]->state());
+        assert(1 == counters[i].starts);
+        assert(kRounds == counters[i].pauses);
+        assert(kRounds == counters[i].resumes);
+        assert(1 == counters[i].cancels && 1 == counters[i].ends);
+    }
+}
+
+int main() {
+    TestRunsInOrder();
+    TestTickObserverRunsFirst();
+    TestManyProducers();
+    return 0;
+}
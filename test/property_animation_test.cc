@@ -0,0 +1,89 @@
+#include <cassert>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_property_animation.hpp"
+
+using anim::AnimationDriver;
+using anim::Keyframe;
+using anim::PointerProperty;
+using anim::PropertyAnimation;
+using anim::SetterProperty;
+using anim::StridedProperty;
+
+class Sprite
+{
+public:
+    void set_alpha(float alpha) { alpha_ = alpha; ++alpha_updates_; }
+    float alpha() const { return alpha_; }
+    int alpha_updates() const { return alpha_updates_; }
+
+    float x = 0.0f;
+    int layer = 7;
+
+private:
+    float alpha_ = 0.0f;
+    int alpha_updates_ = 0;
+};
+
+static void Run(AnimationDriver &driver) {
+    for (long time = 0; !driver.IsIdle(); time += 10) {
+        driver.Tick(time);
+    }
+}
+
+int main() {
+    AnimationDriver driver;
+    Sprite sprite;
+    float raw = -1.0f;
+
+    // Raw pointer, the values match the subscriber of the same animation
+    PropertyAnimation<float> pointer(&raw, 0.0f, 10.0f);
+    pointer.set_driver(&driver);
+    pointer.SetDuration(100);
+    std::vector<float> subscribed;
+    pointer.subscriber_ = [&](const float &value) {
+        // The property is written first
+        assert(*pointer.property().target() == value);
+        subscribed.push_back(value);
+    };
+    // Member pointer
+    PropertyAnimation<float> member({&sprite, &Sprite::x},
+                                    {Keyframe<float>(0.0f, 1.0f), Keyframe<float>(0.5f, 5.0f), Keyframe<float>(1.0f, 2.0f)});
+    member.set_driver(&driver);
+    member.SetDuration(100);
+    // Setter known at compile time
+    PropertyAnimation<float, SetterProperty<Sprite, float, &Sprite::set_alpha>> setter(&sprite, 0.0f, 1.0f);
+    setter.set_driver(&driver);
+    setter.SetDuration(100);
+
+    pointer.Start();
+    member.Start();
+    setter.Start();
+    assert(0.0f == raw && 1.0f == sprite.x && 0.0f == sprite.alpha());
+    Run(driver);
+    assert(10.0f == raw && 2.0f == sprite.x && 1.0f == sprite.alpha());
+    assert(!subscribed.empty() && 10.0f == subscribed.back());
+    assert(sprite.alpha_updates() > 2);
+    assert(7 == sprite.layer);
+
+    // One value written to the same member of every sprite
+    std::vector<Sprite> sprites(100);
+    PropertyAnimation<float, StridedProperty<float>> strided(StridedProperty<float>(sprites.data(), sprites.size(), &Sprite::x),
+                                                             3.0f, 4.0f);
+    strided.set_driver(&driver);
+    strided.SetDuration(50);
+    strided.Start();
+    Run(driver);
+    for (const Sprite &each : sprites) {
+        assert(4.0f == each.x && 7 == each.layer);
+    }
+
+    // Rebinding
+    float other = 0.0f;
+    pointer.set_property(&other);
+    assert(&other == pointer.property().target());
+    pointer.Start();
+    Run(driver);
+    assert(10.0f == other);
+    return 0;
+}
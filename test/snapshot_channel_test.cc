@@ -0,0 +1,118 @@
+// Also meant to run under ThreadSanitizer, see CC_ANIMATION_TSAN
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "cc_animation_driver.hpp"
+#include "cc_property_animation.hpp"
+#include "cc_snapshot_channel.hpp"
+
+using anim::AnimationDriver;
+using anim::PropertyAnimation;
+using anim::SnapshotChannel;
+using anim::SnapshotProperty;
+
+// Every component holds the generation which wrote it, a torn read shows as different components
+struct Vec4
+{
+    int64_t x, y, z, w;
+};
+
+static void TestSingleThread() {
+    SnapshotChannel<float> channel(3, -1.0f);
+    uint64_t generation = 99;
+    const float *values = channel.Acquire(&generation);
+    assert(0 == generation && -1.0f == values[0]);
+
+    channel.Write(1, 5.0f);
+    // Not visible before it is published
+    values = channel.Acquire(&generation);
+    assert(0 == generation && -1.0f == values[1]);
+    channel.Publish();
+    values = channel.Acquire(&generation);
+    assert(1 == generation && -1.0f == values[0] && 5.0f == values[1]);
+
+    // Frames skipped by the reader, and buffers far behind which need a full copy
+    for (int i = 0; i < 20; ++i) {
+        channel.Write(size_t(i % 3), float(i));
+        channel.Publish();
+        if (i % 7 == 0) {
+            values = channel.Acquire(&generation);
+            assert(generation == channel.generation());
+            for (size_t slot = 0; slot < 3; ++slot) assert(values[slot] == channel.value(slot));
+        }
+    }
+    values = channel.Acquire(&generation);
+    assert(21 == generation && 18.0f == values[0] && 19.0f == values[1] && 17.0f == values[2]);
+    // Nothing new, the same frame again
+    assert(values == channel.Acquire(&generation) && 21 == generation);
+}
+
+static void TestAnimations() {
+    AnimationDriver driver;
+    SnapshotChannel<float> channel(2);
+    PropertyAnimation<float, SnapshotProperty<float>> a(SnapshotProperty<float>(&channel, 0), 0.0f, 10.0f);
+    PropertyAnimation<float, SnapshotProperty<float>> b(SnapshotProperty<float>(&channel, 1), 10.0f, 20.0f);
+    for (auto animation : {&a, &b}) {
+        animation->set_driver(&driver);
+        animation->SetDuration(100);
+        animation->Start();
+    }
+    for (long time = 0; !driver.IsIdle(); time += 10) {
+        driver.Tick(time);
+        channel.Publish();
+    }
+    const float *values = channel.Acquire();
+    assert(10.0f == values[0] && 20.0f == values[1]);
+}
+
+static void TestConcurrentReader() {
+    const size_t kSlots = 64;
+    const int64_t kFrames = 20000;
+    SnapshotChannel<Vec4> channel(kSlots, Vec4{0, 0, 0, 0});
+    std::atomic<bool> done(false);
+
+    std::thread reader([&] {
+        std::vector<int64_t> last(kSlots, 0);
+        uint64_t last_generation = 0;
+        for (;;) {
+            const bool finished = done.load(std::memory_order_acquire);
+            uint64_t generation = 0;
+            const Vec4 *values = channel.Acquire(&generation);
+            assert(generation >= last_generation);
+            last_generation = generation;
+            for (size_t slot = 0; slot < kSlots; ++slot) {
+                const Vec4 &v = values[slot];
+                assert(v.x == v.y && v.y == v.z && v.z == v.w);
+                assert(v.x >= last[slot] && v.x <= int64_t(generation));
+                last[slot] = v.x;
+            }
+            // Slot 0 is written every frame
+            assert(values[0].x == int64_t(generation));
+            if (finished) {
+                assert(int64_t(generation) == kFrames);
+                break;
+            }
+        }
+    });
+
+    for (int64_t frame = 1; frame <= kFrames; ++frame) {
+        // A varying subset of the slots changes each frame
+        for (size_t slot = 0; slot < kSlots; ++slot) {
+            if (0 == slot || 0 == (frame + int64_t(slot)) % int64_t(slot + 1)) {
+                channel.Write(slot, Vec4{frame, frame, frame, frame});
+            }
+        }
+        channel.Publish();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+}
+
+int main() {
+    TestSingleThread();
+    TestAnimations();
+    TestConcurrentReader();
+    return 0;
+}
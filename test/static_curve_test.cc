@@ -0,0 +1,67 @@
+#include <cassert>
+#include <vector>
+#include "cc_static_curve.hpp"
+#include "cc_value_animation.hpp"
+
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::StaticCurve;
+using anim::ValueAnimation;
+
+template <CurveType Type>
+static void CheckCurve() {
+    const StaticCurve<Type> curve;
+    const EasingCurve runtime(Type);
+    assert(curve.type() == Type);
+    assert(EasingCurve(curve).type() == Type);
+    // Include progress outside of [0, 1], where some curves overshoot
+    for (int i = -200; i <= 1200; ++i) {
+        const float progress = float(i) / 1000.0f;
+        assert(curve.ValueForProgress(progress) == runtime.ValueForProgress(progress));
+    }
+}
+
+template <CurveType Type>
+static void CheckAnimation() {
+    ValueAnimation<float> dynamic(-20.0f, 80.0f);
+    ValueAnimation<float, StaticCurve<Type>> fixed(-20.0f, 80.0f);
+    dynamic.set_easing_curve(EasingCurve(Type));
+    float dynamic_value = 0.0f;
+    float fixed_value = 0.0f;
+    dynamic.subscriber_ = [&dynamic_value](const float &value) { dynamic_value = value; };
+    fixed.subscriber_ = [&fixed_value](const float &value) { fixed_value = value; };
+    for (long time = 0; time <= dynamic.GetDuration(); time += 7) {
+        dynamic.SetCurrentTime(time);
+        fixed.SetCurrentTime(time);
+        assert(dynamic_value == fixed_value);
+    }
+}
+
+int main() {
+    CheckCurve<CurveType::Linear>();
+    CheckCurve<CurveType::InQuad>();
+    CheckCurve<CurveType::OutQuad>();
+    CheckCurve<CurveType::InOutQuad>();
+    CheckCurve<CurveType::OutInQuad>();
+    CheckCurve<CurveType::InCubic>();
+    CheckCurve<CurveType::OutCubic>();
+    CheckCurve<CurveType::InOutCubic>();
+    CheckCurve<CurveType::OutInCubic>();
+    // Not inlined, goes through the runtime curve
+    CheckCurve<CurveType::OutBounce>();
+    CheckCurve<CurveType::InOutElastic>();
+
+    CheckAnimation<CurveType::InOutQuad>();
+    CheckAnimation<CurveType::OutInCubic>();
+    CheckAnimation<CurveType::InBack>();
+
+    // The default curve is InOutQuad for both forms
+    ValueAnimation<float> dynamic(0.0f, 1.0f);
+    ValueAnimation<float, StaticCurve<CurveType::InOutQuad>> fixed(0.0f, 1.0f);
+    assert(dynamic.easing_curve().type() == CurveType::InOutQuad);
+    assert(fixed.easing_curve().type() == CurveType::InOutQuad);
+    for (long time = 0; time <= dynamic.GetDuration(); time += 10) {
+        assert(dynamic.Evaluate(time) == fixed.Evaluate(time));
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <cassert>
+#include <cmath>
+#include "cc_animation_driver.hpp"
+#include "cc_property_animation.hpp"
+#include "cc_value_types.hpp"
+
+using anim::AnimationDriver;
+using anim::Color;
+using anim::InterpolateValue;
+using anim::Keyframe;
+using anim::PropertyAnimation;
+using anim::Quat;
+using anim::ValueAnimation;
+using anim::Vec2;
+using anim::Vec3;
+using anim::Vec4;
+
+static const float kPi = 3.14159265f;
+
+static bool Near(float a, float b, float epsilon = 1e-5f) { return std::fabs(a - b) <= epsilon; }
+
+static bool SameRotation(const Quat &a, const Quat &b, float epsilon = 1e-5f) {
+    return Near(std::fabs(a.Dot(b)), 1.0f, epsilon);
+}
+
+static void TestLerpMatchesScalar() {
+    const float progress[] = {0.0f, 0.25f, 0.5f, 1.0f, -0.2f, 1.3f};
+    for (float t : progress) {
+        const Vec2 v2 = InterpolateValue<Vec2>(Vec2(1.0f, -2.0f), Vec2(3.5f, 7.0f), t);
+        assert(v2.x == InterpolateValue<float>(1.0f, 3.5f, t) && v2.y == InterpolateValue<float>(-2.0f, 7.0f, t));
+        const Vec4 v4 = InterpolateValue<Vec4>(Vec4(0.1f, 0.2f, 0.3f, 0.4f), Vec4(9.0f, -8.0f, 7.0f, -6.0f), t);
+        assert(v4.x == InterpolateValue<float>(0.1f, 9.0f, t) && v4.w == InterpolateValue<float>(0.4f, -6.0f, t));
+        const Color c = InterpolateValue<Color>(Color(1.0f, 0.0f, 0.0f, 1.0f), Color(0.0f, 0.5f, 0.0f, 0.5f), t);
+        assert(c.g == InterpolateValue<float>(0.0f, 0.5f, t) && c.a == InterpolateValue<float>(1.0f, 0.5f, t));
+    }
+
+    // Only the 3 components are written
+    struct Padded { Vec3 v; float after; } padded{Vec3(), 42.0f};
+    padded.v = InterpolateValue<Vec3>(Vec3(0.0f, 1.0f, 2.0f), Vec3(4.0f, 5.0f, 6.0f), 0.5f);
+    assert(Vec3(2.0f, 3.0f, 4.0f) == padded.v && 42.0f == padded.after);
+}
+
+static void TestColor() {
+    // Mid grey in sRGB is about 21.4 % in linear light
+    const Color grey = Color::FromSrgb(0.5f, 0.5f, 0.5f, 1.0f);
+    assert(Near(grey.r, 0.2140411f));
+    float rgba[4];
+    grey.ToSrgb(rgba);
+    assert(Near(rgba[0], 0.5f) && 1.0f == rgba[3]);
+
+    // Fading red out stays red, premultiplied alpha doesn't bleed the black of the transparent end
+    const Color red = Color::FromSrgb(1.0f, 0.0f, 0.0f, 1.0f);
+    const Color half = InterpolateValue<Color>(red, Color(), 0.5f);
+    half.ToSrgb(rgba);
+    assert(Near(rgba[0], 1.0f) && 0.0f == rgba[1] && 0.5f == rgba[3]);
+    Color().ToSrgb(rgba);
+    assert(0.0f == rgba[0] && 0.0f == rgba[3]);
+}
+
+static void TestQuat() {
+    const Vec3 z(0.0f, 0.0f, 1.0f);
+    const Quat identity;
+    const Quat quarter = Quat::FromAxisAngle(z, kPi / 2);
+    const Vec3 x = quarter.Rotate(Vec3(1.0f, 0.0f, 0.0f));
+    assert(Near(x.x, 0.0f) && Near(x.y, 1.0f) && Near(x.z, 0.0f));
+    assert(SameRotation(quarter * quarter, Quat::FromAxisAngle(z, kPi)));
+
+    // Constant angular speed, exact at the end
+    assert(SameRotation(anim::Slerp(identity, quarter, 0.5f), Quat::FromAxisAngle(z, kPi / 4)));
+    assert(SameRotation(anim::Slerp(identity, quarter, 0.25f), Quat::FromAxisAngle(z, kPi / 8)));
+    assert(quarter == anim::Slerp(identity, quarter, 1.0f));
+    assert(SameRotation(identity, anim::Slerp(identity, quarter, 0.0f)));
+    assert(SameRotation(quarter, InterpolateValue<Quat>(identity, quarter, 1.0f)));
+
+    // The shorter way round: -quarter is the same rotation as quarter
+    const Quat negated(-quarter.x, -quarter.y, -quarter.z, -quarter.w);
+    assert(SameRotation(anim::Slerp(identity, negated, 0.5f), Quat::FromAxisAngle(z, kPi / 4)));
+    assert(SameRotation(anim::Nlerp(identity, negated, 0.5f), Quat::FromAxisAngle(z, kPi / 4)));
+
+    // Unit length, also when falling back to nlerp for close rotations
+    const Quat close = Quat::FromAxisAngle(z, 0.01f);
+    for (float t = 0.0f; t <= 1.0f; t += 0.125f) {
+        const Quat slerped = anim::Slerp(quarter, Quat::FromAxisAngle(Vec3(1.0f, 1.0f, 0.0f), 2.0f), t);
+        assert(Near(slerped.Dot(slerped), 1.0f));
+        const Quat nlerped = anim::Nlerp(identity, close, t);
+        assert(Near(nlerped.Dot(nlerped), 1.0f));
+        assert(SameRotation(nlerped, Quat::FromAxisAngle(z, 0.01f * t), 1e-6f));
+    }
+}
+
+struct Sprite {
+    Vec3 position;
+    Color color;
+    Quat rotation;
+};
+
+static void TestAnimations() {
+    AnimationDriver driver;
+    Sprite sprite;
+    PropertyAnimation<Vec3> move(&sprite.position, Vec3(0.0f, 0.0f, 0.0f), Vec3(10.0f, 20.0f, 30.0f));
+    PropertyAnimation<Color> fade(&sprite.color, Color(1.0f, 1.0f, 1.0f, 1.0f), Color());
+    const Vec3 y(0.0f, 1.0f, 0.0f);
+    PropertyAnimation<Quat> spin(&sprite.rotation, {Keyframe<Quat>(0.0f, Quat()),
+                                                     Keyframe<Quat>(0.5f, Quat::FromAxisAngle(y, kPi / 2)),
+                                                     Keyframe<Quat>(1.0f, Quat::FromAxisAngle(y, kPi))});
+    for (anim::Animation *animation : {static_cast<anim::Animation *>(&move), static_cast<anim::Animation *>(&fade),
+                                       static_cast<anim::Animation *>(&spin)}) {
+        animation->set_driver(&driver);
+        animation->SetDuration(100L);
+        animation->Start();
+    }
+    move.set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+    spin.set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+    driver.Tick(0L);
+    driver.Tick(50L);
+    assert(Vec3(5.0f, 10.0f, 15.0f) == sprite.position);
+    assert(SameRotation(sprite.rotation, Quat::FromAxisAngle(y, kPi / 2)));
+    driver.Tick(100L);
+    assert(Vec3(10.0f, 20.0f, 30.0f) == sprite.position && Color() == sprite.color);
+    assert(SameRotation(sprite.rotation, Quat::FromAxisAngle(y, kPi)));
+
+    // Evaluate() goes through the same interpolation
+    ValueAnimation<Vec2> slide(Vec2(0.0f, 0.0f), Vec2(8.0f, -8.0f));
+    slide.set_easing_curve(anim::EasingCurve(anim::CurveType::Linear));
+    slide.SetDuration(100L);
+    assert(Vec2(2.0f, -2.0f) == slide.Evaluate(25L));
+}
+
+int main() {
+    TestLerpMatchesScalar();
+    TestColor();
+    TestQuat();
+    TestAnimations();
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Bakes keyframes described in a text file into a clip file read by anim::ClipFile.
+//
+//   clip_bake <input.txt> <output.ccac>
+//
+// The input holds one clip after another, '#' starts a comment:
+//
+//   clip <name> <float|double|int> <duration in ms>
+//   key <progress> <value> [<curve name> | bezier <x1> <y1> <x2> <y2>]
+//
+// The curve of a key eases the segment to the next key, Linear by default.
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "cc_clip_file.hpp"
+
+using anim::ClipWriter;
+using anim::CurveType;
+using anim::EasingCurve;
+using anim::Keyframe;
+
+static const char *kCurveNames[] = {
+    "Linear", "InQuad", "OutQuad", "InOutQuad", "OutInQuad", "InCubic", "OutCubic", "InOutCubic", "OutInCubic",
+    "InQuart", "OutQuart", "InOutQuart", "OutInQuart", "InQuint", "OutQuint", "InOutQuint", "OutInQuint",
+    "InSine", "OutSine", "InOutSine", "OutInSine", "InExpo", "OutExpo", "InOutExpo", "OutInExpo",
+    "InCirc", "OutCirc", "InOutCirc", "OutInCirc", "InElastic", "OutElastic", "InOutElastic", "OutInElastic",
+    "InBack", "OutBack", "InOutBack", "OutInBack", "InBounce", "OutBounce", "InOutBounce", "OutInBounce",
+    "InCurve", "OutCurve", "SineCurve", "CosineCurve", "CubicBezier"};
+
+struct PendingKey
+{
+    float progress;
+    double value;
+    EasingCurve curve;
+};
+
+struct PendingClip
+{
+    std::string name;
+    std::string type;
+    long duration_ms = 0;
+    std::vector<PendingKey> keys;
+};
+
+static bool ParseCurve(std::istringstream &in, EasingCurve *curve) {
+    std::string name;
+    if (!(in >> name)) return true;
+    if ("bezier" == name) {
+        float x1, y1, x2, y2;
+        if (!(in >> x1 >> y1 >> x2 >> y2)) return false;
+        *curve = EasingCurve::Bezier(x1, y1, x2, y2);
+        return true;
+    }
+    for (size_t i = 0; i < sizeof(kCurveNames) / sizeof(kCurveNames[0]); ++i) {
+        if (name == kCurveNames[i]) {
+            *curve = EasingCurve(CurveType(i));
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+static bool AddClip(ClipWriter &writer, const PendingClip &clip) {
+    std::vector<Keyframe<T>> keyframes;
+    for (const PendingKey &key : clip.keys) {
+        keyframes.push_back(Keyframe<T>(key.progress, T(key.value), key.curve));
+    }
+    return writer.AddClip(clip.name, std::move(keyframes), std::chrono::milliseconds(clip.duration_ms));
+}
+
+static bool AddClip(ClipWriter &writer, const PendingClip &clip) {
+    if ("float" == clip.type) return AddClip<float>(writer, clip);
+    if ("double" == clip.type) return AddClip<double>(writer, clip);
+    if ("int" == clip.type) return AddClip<int>(writer, clip);
+    return false;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <input.txt> <output.ccac>\n", argv[0]);
+        return 2;
+    }
+    std::ifstream input(argv[1]);
+    if (!input) {
+        std::fprintf(stderr, "%s: can't read %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    ClipWriter writer;
+    PendingClip clip;
+    std::string line;
+    int line_number = 0;
+    auto flush = [&]() {
+        if (clip.name.empty()) return true;
+        if (!AddClip(writer, clip)) {
+            std::fprintf(stderr, "%s: can't bake clip %s\n", argv[1], clip.name.c_str());
+            return false;
+        }
+        clip = PendingClip();
+        return true;
+    };
+    while (std::getline(input, line)) {
+        ++line_number;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream in(line);
+        std::string keyword;
+        if (!(in >> keyword)) continue;
+        bool parsed = false;
+        if ("clip" == keyword) {
+            if (!flush()) return 1;
+            parsed = bool(in >> clip.name >> clip.type >> clip.duration_ms);
+        } else if ("key" == keyword && !clip.name.empty()) {
+            PendingKey key{0.0f, 0.0, EasingCurve(CurveType::Linear)};
+            parsed = (in >> key.progress >> key.value) && ParseCurve(in, &key.curve);
+            clip.keys.push_back(key);
+        }
+        if (!parsed) {
+            std::fprintf(stderr, "%s:%d: can't parse \"%s\"\n", argv[1], line_number, line.c_str());
+            return 1;
+        }
+    }
+    if (!flush()) return 1;
+    if (!writer.Write(argv[2])) {
+        std::fprintf(stderr, "%s: can't write %s\n", argv[0], argv[2]);
+        return 1;
+    }
+    std::printf("%zu clips baked into %s\n", writer.clip_count(), argv[2]);
+    return 0;
+}